@@ -4,9 +4,13 @@
 // Advent of Code 2023 Solutions by Arttu Kärpinlehto
 
 #include <map>
+#include <memory>
 #include <set>
+#include <span>
 #include <vector>
 #include <iostream>
+#include <string>
+#include <string_view>
 
 // Global flags.
 extern bool	debug;
@@ -22,11 +26,19 @@ void print_set(std::set<T> s)
 	}
 };
 
+template <typename T, typename A>
+void print_vec(const std::vector<T, A>& v, std::ostream& out = std::cout)
+{
+	for (const auto& i : v) {
+		out << i << " ";
+	}
+};
+
 template <typename T>
-void print_vec(std::vector<T> v)
+void print_vec(std::span<const T> v, std::ostream& out = std::cout)
 {
 	for (const auto& i : v) {
-		std::cout << i << " ";
+		out << i << " ";
 	}
 };
 
@@ -36,6 +48,54 @@ typedef long (*dayfunction)(int, std::istream& is);
 // Global map of day solution functions.
 extern std::map<int, dayfunction> day_functions;
 
+// Parsed puzzle input.  Each day derives its own parsed state from this.
+struct parsed_input {
+	virtual ~parsed_input() = default;
+};
+
+// Function types for the parse and solve steps of a day solution.
+// Parse step reads the whole puzzle input from memory (usually memory-mapped
+// from the file); the parsed state may refer to it, so the input must outlive
+// the parsed state.  Solve steps do not modify the parsed state, so both parts
+// can be solved from a single parse, even concurrently.
+typedef std::unique_ptr<parsed_input> (*parsefunction)(std::string_view);
+typedef long (*solvefunction)(const parsed_input&);
+
+// Day solution split into parse and solve steps.
+struct daysolver {
+	parsefunction parse;
+	solvefunction part1;
+	solvefunction part2;
+	// Solution that reads the input one line at a time without holding
+	// all of it, or nullptr if the day needs the whole input.
+	dayfunction stream = nullptr;
+	// Serialisation of the parsed state for the cache and the binary input
+	// format, or nullptr.  load() returns nullptr if the data is not valid,
+	// and the parsed state may refer to the data.
+	void (*save)(const parsed_input&, std::string&) = nullptr;
+	std::unique_ptr<parsed_input> (*load)(std::string_view) = nullptr;
+
+	// Solve the given puzzle part (1 or 2) using the parsed state.
+	long solve(int part, const parsed_input& input) const {
+		return (1 == part) ? part1(input) : part2(input);
+	}
+};
+// Global map of day solvers.
+extern std::map<int, daysolver> day_solvers;
+
+// Alternative engine of a day solution, solving from the same parsed state.
+struct day_engine {
+	const char* name;
+	solvefunction part1;
+	solvefunction part2;
+};
+// Global map of day engines, for validating faster solutions against the
+// straightforward ones.  The first engine of a day is the reference.
+extern std::map<int, std::vector<day_engine>> day_engines;
+
+// Puzzle input file name for the day.
+std::string input_filename(int day);
+
 // Prototypes.
 long day01(int, std::istream&);
 long day02(int, std::istream&);
@@ -63,4 +123,57 @@ long day23(int, std::istream&);
 long day24(int, std::istream&);
 long day25(int, std::istream&);
 
+// Parse and solve step prototypes.
+std::unique_ptr<parsed_input> day01_parse(std::string_view);
+long day01_part1(const parsed_input&);
+long day01_part2(const parsed_input&);
+std::unique_ptr<parsed_input> day02_parse(std::string_view);
+long day02_part1(const parsed_input&);
+long day02_part2(const parsed_input&);
+std::unique_ptr<parsed_input> day03_parse(std::string_view);
+long day03_part1(const parsed_input&);
+long day03_part2(const parsed_input&);
+long day03_box_part1(const parsed_input&);
+long day03_box_part2(const parsed_input&);
+std::unique_ptr<parsed_input> day04_parse(std::string_view);
+long day04_part1(const parsed_input&);
+long day04_part2(const parsed_input&);
+std::unique_ptr<parsed_input> day05_parse(std::string_view);
+long day05_part1(const parsed_input&);
+long day05_part2(const parsed_input&);
+void day05_save(const parsed_input&, std::string&);
+std::unique_ptr<parsed_input> day05_load(std::string_view);
+long day05_brute_part1(const parsed_input&);
+long day05_brute_part2(const parsed_input&);
+long day05_vector_part1(const parsed_input&);
+long day05_vector_part2(const parsed_input&);
+std::unique_ptr<parsed_input> day06_parse(std::string_view);
+long day06_part1(const parsed_input&);
+long day06_part2(const parsed_input&);
+long day06_loop_part1(const parsed_input&);
+long day06_loop_part2(const parsed_input&);
+std::unique_ptr<parsed_input> day07_parse(std::string_view);
+long day07_part1(const parsed_input&);
+long day07_part2(const parsed_input&);
+void day07_save(const parsed_input&, std::string&);
+std::unique_ptr<parsed_input> day07_load(std::string_view);
+std::unique_ptr<parsed_input> day08_parse(std::string_view);
+long day08_part1(const parsed_input&);
+long day08_part2(const parsed_input&);
+std::unique_ptr<parsed_input> day09_parse(std::string_view);
+long day09_part1(const parsed_input&);
+long day09_part2(const parsed_input&);
+void day09_save(const parsed_input&, std::string&);
+std::unique_ptr<parsed_input> day09_load(std::string_view);
+std::unique_ptr<parsed_input> day10_parse(std::string_view);
+long day10_part1(const parsed_input&);
+long day10_part2(const parsed_input&);
+std::unique_ptr<parsed_input> day11_parse(std::string_view);
+long day11_part1(const parsed_input&);
+long day11_part2(const parsed_input&);
+void day11_save(const parsed_input&, std::string&);
+std::unique_ptr<parsed_input> day11_load(std::string_view);
+long day11_pairs_part1(const parsed_input&);
+long day11_pairs_part2(const parsed_input&);
+
 #endif /* _AOC_H_ */
@@ -0,0 +1,113 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+#include <sys/mman.h>
+
+#include "aocarena.h"
+
+
+// Size of a huge page on x86-64.
+constexpr size_t huge_page = 2 << 20;
+
+
+arena_resource::arena_resource(bool huge_pages, size_t chunk_size)
+	: huge_pages(huge_pages), chunk_size(chunk_size)
+{
+}
+
+
+arena_resource::~arena_resource()
+{
+	for (const auto& c : chunks) munmap(c.base, c.size);
+}
+
+
+void arena_resource::reset()
+{
+	current = 0;
+	ptr = chunks.empty() ? nullptr : chunks[0].base;
+	end = chunks.empty() ? nullptr : chunks[0].base + chunks[0].size;
+	used = 0;
+}
+
+
+size_t arena_resource::reserved() const
+{
+	size_t total = 0;
+	for (const auto& c : chunks) total += c.size;
+	return total;
+}
+
+
+void* arena_resource::do_allocate(size_t bytes, size_t alignment)
+{
+	auto p = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(ptr) + alignment - 1) & ~(alignment - 1));
+	if ((nullptr == ptr) || (p + bytes > end)) {
+		next_chunk(bytes + alignment);
+		p = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(ptr) + alignment - 1) & ~(alignment - 1));
+	}
+	ptr = p + bytes;
+	used += bytes;
+	peak_used = std::max(peak_used, used);
+	return p;
+}
+
+
+// Move on to the next chunk with at least 'bytes' free, mapping a new one
+// if the chunks kept from before a reset are all used.  New chunks double
+// in size, up to 64 times the first one.
+void arena_resource::next_chunk(size_t bytes)
+{
+	while (++current < chunks.size()) {
+		if (chunks[current].size >= bytes) {
+			ptr = chunks[current].base;
+			end = ptr + chunks[current].size;
+			return;
+		}
+	}
+
+	size_t granule = huge_pages ? huge_page : 4096;
+	size_t size = std::max(chunk_size << std::min<size_t>(chunks.size(), 6), bytes);
+	size = (size + granule - 1) / granule * granule;
+
+	void* base = MAP_FAILED;
+	if (huge_pages) {
+		base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (MAP_FAILED != base) ++hugetlb_chunks;
+	}
+	if (MAP_FAILED == base) {
+		base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (MAP_FAILED == base) throw std::bad_alloc();
+		if (huge_pages) madvise(base, size, MADV_HUGEPAGE);
+	}
+
+	// New chunks go last, so that the loop above finds them after a reset.
+	chunks.push_back({ static_cast<char*>(base), size });
+	current = chunks.size() - 1;
+	ptr = chunks[current].base;
+	end = ptr + size;
+}
+
+
+static thread_local std::pmr::memory_resource* current_resource = nullptr;
+
+std::pmr::memory_resource* day_resource()
+{
+	return current_resource ? current_resource : std::pmr::new_delete_resource();
+}
+
+
+arena_scope::arena_scope(arena_resource& arena) : previous(current_resource)
+{
+	current_resource = &arena;
+}
+
+
+arena_scope::~arena_scope()
+{
+	current_resource = previous;
+}
@@ -0,0 +1,74 @@
+#ifndef _AOCARENA_H_
+#define _AOCARENA_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for the working memory of one day invocation.
+// Memory is handed out from large chunks and never freed one allocation at
+// a time: deallocate() does nothing, and reset() makes all of it available
+// again.  Chunks are kept over a reset, so repeated invocations reuse the
+// same pages.  With huge pages the chunks are mapped with MAP_HUGETLB when
+// the system has huge pages reserved, and otherwise advised to use
+// transparent huge pages.
+class arena_resource : public std::pmr::memory_resource {
+public:
+	explicit arena_resource(bool huge_pages = false, size_t chunk_size = 1 << 20);
+	~arena_resource();
+
+	arena_resource(const arena_resource&) = delete;
+	arena_resource& operator=(const arena_resource&) = delete;
+
+	// Forget all allocations.  Containers using the arena must be gone.
+	void reset();
+
+	size_t allocated() const { return used; }		// Bytes allocated since reset.
+	size_t peak() const { return peak_used; }		// Most bytes allocated between resets.
+	size_t reserved() const;						// Bytes mapped in chunks.
+	bool hugetlb() const { return hugetlb_chunks > 0; }	// Any chunk got MAP_HUGETLB pages.
+
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override;
+	void do_deallocate(void*, size_t, size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+	void next_chunk(size_t bytes);
+
+	struct chunk {
+		char* base;
+		size_t size;
+	};
+	std::vector<chunk> chunks;
+	size_t current = 0;		// Chunk being allocated from.
+	char* ptr = nullptr;	// Next free byte in the current chunk.
+	char* end = nullptr;
+	size_t used = 0;
+	size_t peak_used = 0;
+	const bool huge_pages;
+	const size_t chunk_size;
+	int hugetlb_chunks = 0;
+};
+
+
+// Memory resource for the day invocation running on this thread: the arena
+// of the innermost arena_scope, or the default new/delete resource outside
+// of one.  Containers of the day solutions are constructed with it.
+std::pmr::memory_resource* day_resource();
+
+// Makes an arena the day_resource() of this thread for its lifetime.
+class arena_scope {
+public:
+	explicit arena_scope(arena_resource& arena);
+	~arena_scope();
+
+	arena_scope(const arena_scope&) = delete;
+	arena_scope& operator=(const arena_scope&) = delete;
+
+private:
+	std::pmr::memory_resource* previous;
+};
+
+#endif /* _AOCARENA_H_ */
@@ -0,0 +1,513 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <cmath>
+
+#include "aoc.h"
+#include "aocarena.h"
+#include "aocbench.h"
+#include "aoccounters.h"
+#include "aocinput.h"
+#include "aocisa.h"
+#include "aocpool.h"
+#include "aocreport.h"
+
+
+// Return the p:th percentile (nearest-rank method) of sorted samples.
+static long percentile(const std::vector<long>& sorted, double p)
+{
+	size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+	if (rank < 1) rank = 1;
+	return sorted[rank - 1];
+}
+
+
+std::string duration(long ns)
+{
+	std::stringstream s;
+	s << std::fixed << std::setprecision(3);
+	if (ns < 1000) s << ns << " ns";
+	else if (ns < 1000000) s << ns / 1e3 << " µs";
+	else if (ns < 1000000000) s << ns / 1e6 << " ms";
+	else s << ns / 1e9 << " s";
+	return s.str();
+}
+
+
+// Print the hardware performance counters per iteration, and the derived
+// instructions per cycle and misses per input byte.
+static void print_counters(const perf_counters::values& parse, const perf_counters::values& solve, int iterations, size_t bytes)
+{
+	auto cell = [](double v, int precision) {
+		std::stringstream s;
+		if (v < 0) s << "n/a";
+		else s << std::fixed << std::setprecision(precision) << v;
+		return s.str();
+	};
+	auto row = [&](const std::string& name, double p, double s, double t, int precision) {
+		std::cout << std::setw(20) << std::left << name << std::right
+			<< std::setw(14) << cell(p, precision) << std::setw(14) << cell(s, precision) << std::setw(14) << cell(t, precision) << "\n";
+	};
+	auto total = [&](int e) { return (parse[e] < 0) ? -1.0 : static_cast<double>(parse[e] + solve[e]); };
+	auto per = [](double v, double d) { return ((v < 0) || (d <= 0)) ? -1.0 : v / d; };
+
+	std::cout << std::setw(20) << std::left << "Per iteration" << std::right
+		<< std::setw(14) << "Parse" << std::setw(14) << "Solve" << std::setw(14) << "Total" << "\n";
+	for (int e = 0; e < perf_counters::events; ++e) {
+		row(perf_counters::name(static_cast<perf_counters::event>(e)),
+			per(parse[e], iterations), per(solve[e], iterations), per(total(e), iterations), 0);
+	}
+	row("IPC",
+		per(parse[perf_counters::instructions], parse[perf_counters::cycles]),
+		per(solve[perf_counters::instructions], solve[perf_counters::cycles]),
+		per(total(perf_counters::instructions), total(perf_counters::cycles)), 2);
+	for (auto e : { perf_counters::l1d_misses, perf_counters::llc_misses, perf_counters::branch_misses }) {
+		double input_bytes = static_cast<double>(bytes) * iterations;
+		row(std::string(perf_counters::name(e)) + "/byte",
+			per(parse[e], input_bytes), per(solve[e], input_bytes), per(total(e), input_bytes), 4);
+	}
+	std::cout << std::flush;
+}
+
+
+// Compare the iterations against a baseline JSON file of the same day and
+// part, and print the verdict.  Returns nonzero if the current run is
+// significantly slower, or the baseline cannot be used.
+static int compare_baseline(const std::string& filename, double threshold, const std::vector<bench_record>& records)
+{
+	std::vector<bench_record> baseline_records;
+	std::string error;
+	if (!read_json(filename, baseline_records, error)) {
+		std::cerr << "Cannot read baseline: " << error << std::endl;
+		return 1;
+	}
+
+	const auto& first = records.front();
+	std::vector<long> baseline, current;
+	std::string revision;
+	bool same_input = true;
+	for (const auto& r : baseline_records) {
+		if ((r.day != first.day) || (r.part != first.part)) continue;
+		baseline.push_back(r.total_ns);
+		revision = r.revision;
+		if (r.input_hash != first.input_hash) same_input = false;
+	}
+	for (const auto& r : records) current.push_back(r.total_ns);
+	if (baseline.empty()) {
+		std::cerr << "No day " << first.day << " part " << first.part << " iterations in " << filename << std::endl;
+		return 1;
+	}
+
+	auto c = compare(baseline, current, threshold / 100);
+	auto percent = [](double ratio) {
+		std::stringstream s;
+		s << std::showpos << std::fixed << std::setprecision(1) << (ratio - 1.0) * 100 << " %";
+		return s.str();
+	};
+
+	if (use_colors) std::cout << "\x1B[34m";
+	std::cout << "Baseline: " << filename << ", revision " << revision << ", " << baseline.size() << " iterations" << std::endl;
+	if (use_colors) std::cout << "\x1B[0m";
+	if (!same_input) std::cout << "Warning: baseline was measured with a different puzzle input" << std::endl;
+	std::cout << "Median:   " << duration(c.baseline_median) << " -> " << duration(c.current_median)
+		<< " (" << percent(c.ratio) << ")\n"
+		<< "95% CI:   [" << percent(c.low) << ", " << percent(c.high) << "]\n"
+		<< "Verdict:  ";
+	if (c.slower) {
+		if (use_colors) std::cout << "\x1B[1;31m";
+		std::cout << "SLOWER (significant, over " << std::defaultfloat << threshold << " %)";
+	} else if (c.faster) {
+		if (use_colors) std::cout << "\x1B[1;32m";
+		std::cout << "FASTER (significant, over " << std::defaultfloat << threshold << " %)";
+	} else {
+		std::cout << "no significant change";
+	}
+	if (use_colors) std::cout << "\x1B[0m";
+	std::cout << std::endl;
+
+	return c.slower ? 1 : 0;
+}
+
+
+// Time a function call, in nanoseconds.
+template <typename F>
+static long timed(F f)
+{
+	auto t0 = std::chrono::steady_clock::now();
+	f();
+	auto t1 = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+}
+
+
+// Run a step and store any error message it throws.
+template <typename F>
+static void guarded(std::string& error, F step)
+{
+	try {
+		step();
+	} catch (const char* e) {
+		error = e;
+	} catch (const std::exception& e) {
+		error = e.what();
+	}
+}
+
+
+int bench(int day, int part, const bench_options& options, const std::string& filename)
+{
+	int iterations = options.iterations;
+	auto f = day_solvers.find(day);
+	if (f == day_solvers.end()) {
+		std::cerr << "No solution for day " << day << std::endl;
+		return 1;
+	}
+	const auto& solver = f->second;
+
+	// Map the whole puzzle input into memory once.
+	mapped_input file(filename);
+	if (!file.is_open()) {
+		std::cerr << "Cannot open " << filename << std::endl;
+		return 1;
+	}
+	auto input = file.view();
+
+	// Debug output would dominate the measurements.
+	debug = false;
+
+	// Parse and solve allocate from arenas of their own, which are reset
+	// after each iteration.  The parsed input must be gone before that.
+	arena_resource parse_arena(options.huge_pages), solve_arena(options.huge_pages);
+	auto parse = [&](std::unique_ptr<parsed_input>& parsed) {
+		arena_scope scope(parse_arena);
+		parsed = solver.parse(input);
+	};
+	auto solve = [&](const parsed_input& parsed) {
+		arena_scope scope(solve_arena);
+		return solver.solve(part, parsed);
+	};
+	auto reset = [&](std::unique_ptr<parsed_input>& parsed) {
+		parsed.reset();
+		parse_arena.reset();
+		solve_arena.reset();
+	};
+
+	// Input that does not parse, like binary input of another day, is not benchmarked.
+	{
+		std::string error;
+		std::unique_ptr<parsed_input> parsed;
+		guarded(error, [&]() { parse(parsed); });
+		reset(parsed);
+		if (!error.empty()) {
+			std::cerr << filename << ": " << error << std::endl;
+			return 1;
+		}
+	}
+
+	// Warm-up: caches, branch predictors, page faults and CPU clock ramp-up.
+	int warmup = std::max(1, iterations / 10);
+	long result = 0;
+	for (int i = 0; i < warmup; ++i) {
+		std::unique_ptr<parsed_input> parsed;
+		parse(parsed);
+		result = solve(*parsed);
+		reset(parsed);
+	}
+
+	// Parse and solve steps are timed separately.
+	std::vector<long> parse_samples, solve_samples, total_samples;
+	parse_samples.reserve(iterations);
+	solve_samples.reserve(iterations);
+	total_samples.reserve(iterations);
+	bool consistent = true;
+	std::vector<bench_record> records;
+	records.reserve(iterations);
+
+	// Counters are read between the steps, outside the timed parts.
+	std::unique_ptr<perf_counters> counters;
+	perf_counters::values parse_counts {}, solve_counts {};
+	if (options.counters) {
+		counters = std::make_unique<perf_counters>();
+		if (counters->available()) counters->start();
+	}
+	auto count = [&](perf_counters::values& sum, const perf_counters::values& before, const perf_counters::values& after) {
+		for (size_t e = 0; e < sum.size(); ++e) sum[e] = (before[e] < 0) ? -1 : sum[e] + after[e] - before[e];
+	};
+
+	for (int i = 0; i < iterations; ++i) {
+		std::unique_ptr<parsed_input> parsed;
+		long r = 0;
+		perf_counters::values c0, c1, c2;
+		if (counters) c0 = counters->read();
+		long parse_ns = timed([&]() { parse(parsed); });
+		if (counters) c1 = counters->read();
+		long solve_ns = timed([&]() { r = solve(*parsed); });
+		if (counters) {
+			c2 = counters->read();
+			count(parse_counts, c0, c1);
+			count(solve_counts, c1, c2);
+		}
+		parse_samples.push_back(parse_ns);
+		solve_samples.push_back(solve_ns);
+		total_samples.push_back(parse_ns + solve_ns);
+		if (r != result) consistent = false;
+
+		bench_record record;
+		record.iteration = i + 1;
+		record.parse_ns = parse_ns;
+		record.solve_ns = solve_ns;
+		record.total_ns = parse_ns + solve_ns;
+		record.result = r;
+		records.push_back(record);
+		reset(parsed);
+	}
+	std::sort(parse_samples.begin(), parse_samples.end());
+	std::sort(solve_samples.begin(), solve_samples.end());
+	std::sort(total_samples.begin(), total_samples.end());
+
+	long median = percentile(total_samples, 50);
+	double mbps = (median > 0) ? (input.size() / 1e6) / (median / 1e9) : 0;
+
+	// One row of the latency table.
+	auto row = [&](const char* name, double p) {
+		std::cout << std::setw(8) << std::left << name << std::right
+			<< std::setw(14) << duration(percentile(parse_samples, p))
+			<< std::setw(14) << duration(percentile(solve_samples, p))
+			<< std::setw(14) << duration(percentile(total_samples, p)) << "\n";
+	};
+
+	if (use_colors) std::cout << "\x1B[34m";
+	std::cout << "Benchmark: " << filename << ", " << input.size() << " bytes, "
+		<< iterations << " iterations (" << warmup << " warm-up), " << isa_name(current_isa()) << " kernels" << std::endl;
+	if (use_colors) std::cout << "\x1B[0m";
+	std::cout << "Result: " << result << (consistent ? "" : " (INCONSISTENT between runs!)") << "\n";
+	std::cout << std::setw(8) << "" << std::setw(14) << "Parse" << std::setw(14) << "Solve" << std::setw(14) << "Total" << "\n";
+	row("Min", 0);
+	row("Median", 50);
+	row("P90", 90);
+	row("P99", 99);
+	row("Max", 100);
+	std::cout << "Throughput: " << std::fixed << std::setprecision(2) << mbps << " MB/s (median total)" << std::endl;
+	std::cout << "Arena peak: parse " << parse_arena.peak() << " bytes, solve " << solve_arena.peak() << " bytes";
+	if (options.huge_pages) std::cout << ((parse_arena.hugetlb() || solve_arena.hugetlb()) ? ", huge pages" : ", transparent huge pages advised");
+	std::cout << std::endl;
+
+	if (counters) {
+		counters->stop();
+		if (!counters->available()) {
+			std::cout << "Performance counters not available (" << counters->error() << ")" << std::endl;
+		} else {
+			print_counters(parse_counts, solve_counts, iterations, input.size());
+		}
+	}
+
+	// Common fields of the iteration records.
+	std::stringstream hash;
+	hash << std::hex << std::setw(16) << std::setfill('0') << input_hash(input);
+	for (auto& r : records) {
+		r.revision = build_revision();
+		r.day = day;
+		r.part = part;
+		r.input_hash = hash.str();
+		r.input_bytes = input.size();
+	}
+
+	int status = consistent ? 0 : 1;
+	if (!options.json.empty() && !write_json(options.json, records)) {
+		std::cerr << "Cannot write " << options.json << std::endl;
+		status = 1;
+	}
+	if (!options.csv.empty() && !write_csv(options.csv, records)) {
+		std::cerr << "Cannot write " << options.csv << std::endl;
+		status = 1;
+	}
+	if (!options.compare.empty()) {
+		if (0 != compare_baseline(options.compare, options.threshold, records)) status = 1;
+	}
+
+	return status;
+}
+
+
+int run_all()
+{
+	// One job for each day: parse once, then solve both parts concurrently.
+	struct partjob {
+		long result = 0;
+		long ns = 0;
+		std::string error;
+	};
+	struct dayjob {
+		int day;
+		const daysolver* solver;
+		const mapped_input* input = nullptr;	// nullptr when there is no puzzle input file.
+		std::unique_ptr<arena_resource> arena;	// Parsed input lives here, declared first to outlive it.
+		std::unique_ptr<parsed_input> parsed;
+		long parse_ns = 0;
+		std::string error;
+		partjob parts[2];
+	};
+
+	// Map all puzzle inputs into memory before starting the clock.
+	std::vector<std::unique_ptr<mapped_input>> inputs;
+	std::vector<dayjob> jobs;
+	jobs.reserve(day_solvers.size());
+	for (const auto& f : day_solvers) {
+		const mapped_input* pinput = nullptr;
+		inputs.push_back(std::make_unique<mapped_input>(input_filename(f.first)));
+		if (inputs.back()->is_open()) pinput = inputs.back().get();
+		jobs.push_back({ f.first, &f.second, pinput });
+	}
+
+	// Debug output from several threads would be just noise.
+	debug = false;
+
+	auto t0 = std::chrono::steady_clock::now();
+	size_t workers;
+	{
+		worker_pool pool;
+		workers = pool.size();
+		for (auto& j : jobs) {
+			if (nullptr == j.input) continue;
+			pool.submit([&j, &pool]() {
+				j.arena = std::make_unique<arena_resource>();
+				arena_scope scope(*j.arena);
+				j.parse_ns = timed([&]() { guarded(j.error, [&]() { j.parsed = j.solver->parse(j.input->view()); }); });
+				if (!j.error.empty()) return;
+				// Parsed state is shared read-only by both parts.
+				for (int part = 1; part <= 2; ++part) {
+					pool.submit([&j, part]() {
+						auto& p = j.parts[part - 1];
+						arena_resource arena;
+						arena_scope scope(arena);
+						p.ns = timed([&]() { guarded(p.error, [&]() { p.result = j.solver->solve(part, *j.parsed); }); });
+					});
+				}
+			});
+		}
+		pool.wait();
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	long wall = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+
+	// Timing table.
+	long cpu = 0;
+	int failures = 0;
+	std::cout << "Day  Part  " << std::setw(20) << std::left << "Result" << std::right
+		<< std::setw(14) << "Parse" << std::setw(14) << "Solve" << "\n";
+	for (const auto& j : jobs) {
+		for (int part = 1; part <= 2; ++part) {
+			const auto& p = j.parts[part - 1];
+			std::cout << std::setw(3) << j.day << "  " << std::setw(4) << part << "  " << std::left << std::setw(20);
+			if (nullptr == j.input) {
+				std::cout << "(no input)" << std::right << "\n";
+				continue;
+			}
+			const auto& error = j.error.empty() ? p.error : j.error;
+			if (!error.empty()) {
+				std::cout << ("error: " + error) << std::right;
+				failures += 1;
+			} else {
+				std::cout << p.result << std::right;
+			}
+			// Parse time is shown on the first part only, it is shared.
+			std::cout << std::setw(14) << ((1 == part) ? duration(j.parse_ns) : "")
+				<< std::setw(14) << duration(p.ns) << "\n";
+			cpu += p.ns;
+		}
+		cpu += j.parse_ns;
+	}
+	std::cout << "Total wall time: " << duration(wall) << " on " << workers << " workers"
+		<< " (sum of parse and solve times " << duration(cpu) << ")" << std::endl;
+
+	return (failures > 0) ? 1 : 0;
+}
+
+
+int batch(int day, int part, const std::string& dirname)
+{
+	auto f = day_solvers.find(day);
+	if (f == day_solvers.end()) {
+		std::cerr << "No solution for day " << day << std::endl;
+		return 1;
+	}
+	const auto& solver = f->second;
+
+	// Regular files of the directory, in name order.
+	std::vector<std::string> filenames;
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::directory_iterator(dirname, ec)) {
+		if (entry.is_regular_file()) filenames.push_back(entry.path().string());
+	}
+	if (ec) {
+		std::cerr << "Cannot read directory " << dirname << ": " << ec.message() << std::endl;
+		return 1;
+	}
+	std::sort(filenames.begin(), filenames.end());
+
+	struct batchjob {
+		long result = 0;
+		std::string error;
+		bool done = false;
+	};
+	std::vector<batchjob> jobs(filenames.size());
+	std::mutex mutex;
+	std::condition_variable job_done;
+
+	// Debug output from several threads would be just noise.
+	debug = false;
+
+	int failures = 0;
+	worker_pool pool;
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		pool.submit([&, i]() {
+			auto& j = jobs[i];
+			// Each worker reuses its arena from one file to the next.
+			thread_local arena_resource arena;
+			{
+				arena_scope scope(arena);
+				mapped_input input(filenames[i]);
+				if (!input.is_open()) j.error = "cannot open";
+				else guarded(j.error, [&]() { j.result = solver.solve(part, *solver.parse(input.view())); });
+			}
+			arena.reset();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				j.done = true;
+			}
+			job_done.notify_one();
+		});
+	}
+
+	// Results are written in name order as soon as they and the ones before them are done.
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!jobs[i].done) {
+			std::cout.flush();	// Out with what is ready before waiting.
+			job_done.wait(lock, [&]() { return jobs[i].done; });
+		}
+		const auto& j = jobs[i];
+		std::cout << std::filesystem::path(filenames[i]).filename().string() << '\t';
+		if (j.error.empty()) {
+			std::cout << j.result << '\n';
+		} else {
+			std::cout << "error: " << j.error << '\n';
+			failures += 1;
+		}
+	}
+	pool.wait();
+	std::cout.flush();
+
+	return (failures > 0) ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+#ifndef _AOCBENCH_H_
+#define _AOCBENCH_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <string>
+
+// Benchmark options.
+struct bench_options {
+	int iterations = 100;
+	bool counters = false;		// Hardware performance counters, when available.
+	std::string json;			// Write each iteration into this JSON file.
+	std::string csv;			// Write each iteration into this CSV file.
+	std::string compare;		// Compare against the iterations in this JSON file.
+	double threshold = 5.0;		// Smallest change in percent that counts as significant.
+	bool huge_pages = false;	// Back the arenas with huge pages.
+};
+
+// Benchmark a day solution: load the puzzle input once into memory,
+// run the warm-up iterations, then time the given number of runs and
+// print the latency distribution of the parse and solve steps and
+// the throughput.  Parse and solve allocate from arenas that are reset
+// after each iteration.  Optionally the hardware performance counters are read
+// around the parse and solve steps.  The iterations can be written as JSON
+// or CSV, and compared against an earlier JSON file.
+// Returns the process exit code, nonzero also for a significant slowdown.
+int bench(int day, int part, const bench_options& options, const std::string& filename);
+
+// Run every day and part of the registered day solutions concurrently on a
+// worker pool sized to the core count, and print a timing table.
+// Each day input is parsed once and both parts are solved from it.
+// The parse and each solve have an arena of their own.
+// Returns the process exit code.
+int run_all();
+
+// Solve one part of a day for every regular file in a directory, in a
+// single process, concurrently on a worker pool sized to the core count.
+// Results are written to standard output as "filename<TAB>answer" lines in
+// file name order, each as soon as it and the ones before it are done.
+// Returns the process exit code, nonzero if any file failed.
+int batch(int day, int part, const std::string& dirname);
+
+// Print nanoseconds in a human readable unit.
+std::string duration(long ns);
+
+#endif /* _AOCBENCH_H_ */
@@ -0,0 +1,169 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "aoccache.h"
+#include "aocinput.h"
+
+// Solver version of each day, generated by make from the sources.
+static const std::map<int, std::string> solver_versions = {
+#include "aocversions.inc"
+};
+
+
+std::string cache_directory()
+{
+	if (const char* dir = getenv("AOC2023_CACHE")) return dir;
+	if (const char* xdg = getenv("XDG_CACHE_HOME")) return std::string(xdg) + "/aoc2023";
+	if (const char* home = getenv("HOME")) return std::string(home) + "/.cache/aoc2023";
+	return ".aoc2023-cache";
+}
+
+
+answer_cache::answer_cache(int day, std::string_view input, bool enabled)
+{
+	auto version = solver_versions.find(day);
+	if (!enabled || (version == solver_versions.end())) return;
+
+	std::stringstream s;
+	s << "day" << std::setw(2) << std::setfill('0') << day << "-" << std::hex << std::setw(16) << input_hash(input)
+		<< "-" << std::dec << input.size() << "-" << version->second;
+	key = s.str();
+}
+
+
+std::string answer_cache::entry(const std::string& suffix) const
+{
+	return cache_directory() + "/" + key + suffix;
+}
+
+
+// Write to a temporary file first, so that a concurrent run never reads half an entry.
+void answer_cache::store(const std::string& suffix, const std::string& data)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(cache_directory(), ec);
+	std::string name = entry(suffix);
+	std::string temporary = name + ".tmp" + std::to_string(getpid());
+	{
+		std::ofstream out(temporary, std::ios::binary);
+		out << data;
+		if (!out.flush()) {
+			store_failed = true;
+			std::filesystem::remove(temporary, ec);
+			return;
+		}
+	}
+	if (0 != std::rename(temporary.c_str(), name.c_str())) store_failed = true;
+}
+
+
+bool answer_cache::find_answer(int part, long& answer)
+{
+	if (!enabled()) return false;
+	std::ifstream in(entry("-part" + std::to_string(part)));
+	if (in >> answer) {
+		++hits;
+		return true;
+	}
+	++misses;
+	return false;
+}
+
+
+void answer_cache::store_answer(int part, long answer)
+{
+	if (enabled()) store("-part" + std::to_string(part), std::to_string(answer) + "\n");
+}
+
+
+bool answer_cache::find_parsed(std::string& data)
+{
+	if (!enabled()) return false;
+	std::ifstream in(entry("-parsed"), std::ios::binary);
+	if (!in) return false;
+	std::stringstream s;
+	s << in.rdbuf();
+	data = s.str();
+	parsed_loaded = true;
+	return true;
+}
+
+
+void answer_cache::store_parsed(const std::string& data)
+{
+	if (!enabled()) return;
+	store("-parsed", data);
+	parsed_stored = !store_failed;
+}
+
+
+std::string answer_cache::statistics() const
+{
+	if (!enabled()) return "off";
+	std::stringstream s;
+	s << hits << " hit" << ((1 == hits) ? "" : "s") << ", " << misses << " miss" << ((1 == misses) ? "" : "es");
+	if (parsed_loaded) s << ", parsed state loaded";
+	if (parsed_stored) s << ", parsed state stored";
+	if (store_failed) s << ", cannot write " << cache_directory();
+	return s.str();
+}
+
+
+int cache_command(const std::vector<std::string>& args)
+{
+	std::string command = args.empty() ? "stats" : args[0];
+	std::string dir = cache_directory();
+	std::error_code ec;
+
+	if (command == "clear") {
+		long removed = 0;
+		for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+			if ((0 == e.path().filename().string().compare(0, 3, "day")) && std::filesystem::remove(e.path(), ec)) ++removed;
+		}
+		std::cout << "Removed " << removed << " cache entries from " << dir << std::endl;
+		return 0;
+	}
+	if (command != "stats") {
+		std::cerr << "Usage: aoc2023 cache [stats|clear]" << std::endl;
+		return 1;
+	}
+
+	// Entries and bytes of each day, from the file names.
+	struct usage {
+		long answers = 0;
+		long parsed = 0;
+		long bytes = 0;
+	};
+	std::map<int, usage> days;
+	for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+		std::string name = e.path().filename().string();
+		if ((0 != name.compare(0, 3, "day")) || !e.is_regular_file()) continue;
+		auto& u = days[atoi(name.c_str() + 3)];
+		if (name.find("-part") != std::string::npos) ++u.answers;
+		else if (name.find("-parsed") != std::string::npos) ++u.parsed;
+		u.bytes += e.file_size(ec);
+	}
+
+	std::cout << "Cache: " << dir << "\n";
+	std::cout << "Day  " << std::setw(10) << "Answers" << std::setw(14) << "Parsed state" << std::setw(14) << "Bytes" << "\n";
+	usage total;
+	for (const auto& [day, u] : days) {
+		std::cout << std::setw(3) << day << "  " << std::setw(10) << u.answers << std::setw(14) << u.parsed << std::setw(14) << u.bytes << "\n";
+		total.answers += u.answers;
+		total.parsed += u.parsed;
+		total.bytes += u.bytes;
+	}
+	std::cout << "All  " << std::setw(10) << total.answers << std::setw(14) << total.parsed << std::setw(14) << total.bytes << std::endl;
+	return 0;
+}
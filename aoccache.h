@@ -0,0 +1,51 @@
+#ifndef _AOCCACHE_H_
+#define _AOCCACHE_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// On-disk cache of the answers and parsed state of a day, keyed by the
+// puzzle input contents (hash and size), the day and the version of its
+// solver.  The version is a hash of the day source and the scaffolding it
+// uses, so changing the solution invalidates its entries.  Entries are
+// files in $AOC2023_CACHE, or $XDG_CACHE_HOME/aoc2023, or ~/.cache/aoc2023.
+// The cache never fails a run: entries that cannot be read or written are
+// just misses.
+class answer_cache {
+public:
+	answer_cache(int day, std::string_view input, bool enabled = true);
+
+	bool enabled() const { return !key.empty(); }
+
+	bool find_answer(int part, long& answer);
+	void store_answer(int part, long answer);
+	bool find_parsed(std::string& data);
+	void store_parsed(const std::string& data);
+
+	// Statistics of this run, eg. "1 hit, 1 miss, parsed state stored".
+	std::string statistics() const;
+
+private:
+	std::string entry(const std::string& suffix) const;
+	void store(const std::string& suffix, const std::string& data);
+
+	std::string key;	// Empty when disabled.
+	int hits = 0;
+	int misses = 0;
+	bool parsed_loaded = false;
+	bool parsed_stored = false;
+	bool store_failed = false;
+};
+
+// Directory of the cache files.
+std::string cache_directory();
+
+// Cache maintenance: "stats" (the default) prints the number and size of the
+// entries of each day, "clear" removes all entries.
+// Returns the process exit code.
+int cache_command(const std::vector<std::string>& args);
+
+#endif /* _AOCCACHE_H_ */
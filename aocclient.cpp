@@ -0,0 +1,106 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+// Client for the server mode of aoc2023.
+//
+//	aocclient <socket> <day> <part> [file|-] [repeat]
+//
+// Sends the puzzle input (standard input by default) to the server
+// listening on the socket, and prints the answer.  With a repeat count the
+// same request is sent that many times over the same connection, and the
+// time of each round trip is printed too, which shows the server reusing
+// the parsed state.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+static bool write_all(int fd, std::string_view s)
+{
+	while (!s.empty()) {
+		ssize_t w = ::send(fd, s.data(), s.size(), MSG_NOSIGNAL);
+		if ((w < 0) && (EINTR == errno)) continue;
+		if (w <= 0) return false;
+		s.remove_prefix(w);
+	}
+	return true;
+}
+
+// Read the response line without the line feed.
+static bool read_line(int fd, std::string& line)
+{
+	line.clear();
+	for (;;) {
+		char c;
+		ssize_t r = ::read(fd, &c, 1);
+		if ((r < 0) && (EINTR == errno)) continue;
+		if (r <= 0) return false;
+		if ('\n' == c) return true;
+		line += c;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 4) {
+		std::cerr << "Usage: " << argv[0] << " <socket> <day> <part> [file|-] [repeat]" << std::endl;
+		return 1;
+	}
+	std::string filename = (argc > 4) ? argv[4] : "-";
+	int repeat = (argc > 5) ? std::max(1, atoi(argv[5])) : 1;
+
+	std::stringstream input;
+	if ("-" == filename) {
+		input << std::cin.rdbuf();
+	} else {
+		std::ifstream file(filename, std::ios::binary);
+		if (!file) {
+			std::cerr << "Cannot open " << filename << std::endl;
+			return 1;
+		}
+		input << file.rdbuf();
+	}
+	std::string request = std::string(argv[2]) + " " + argv[3] + " " + std::to_string(input.str().size()) + "\n" + input.str();
+
+	sockaddr_un address {};
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, argv[1], sizeof(address.sun_path) - 1);
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if ((fd < 0) || (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)) {
+		std::cerr << argv[1] << ": " << strerror(errno) << std::endl;
+		return 1;
+	}
+
+	int status = 0;
+	for (int i = 0; i < repeat; ++i) {
+		auto t0 = std::chrono::steady_clock::now();
+		std::string response;
+		if (!write_all(fd, request) || !read_line(fd, response)) {
+			std::cerr << "Connection closed by the server" << std::endl;
+			status = 1;
+			break;
+		}
+		auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+		if (0 == response.compare(0, 3, "ok ")) {
+			std::cout << response.substr(3);
+		} else {
+			std::cerr << response << std::endl;
+			status = 1;
+		}
+		if (repeat > 1) std::cout << "\t" << us << " µs";
+		std::cout << std::endl;
+	}
+	::close(fd);
+
+	return status;
+}
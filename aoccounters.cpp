@@ -0,0 +1,108 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "aoccounters.h"
+
+
+// Type and config of each counter, in the order of perf_counters::event.
+static const struct {
+	uint32_t type;
+	uint64_t config;
+	const char* name;
+} counter_events[perf_counters::events] = {
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "Cycles" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "Instructions" },
+	{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), "L1D misses" },
+	{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), "LLC misses" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "Branch misses" },
+};
+
+
+perf_counters::perf_counters()
+{
+	for (int e = 0; e < events; ++e) {
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = counter_events[e].type;
+		attr.config = counter_events[e].config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// This thread, any CPU, no group.
+		fds[e] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		if ((fds[e] < 0) && reason.empty()) {
+			reason = std::string(counter_events[e].name) + ": " + strerror(errno);
+		}
+	}
+}
+
+
+perf_counters::~perf_counters()
+{
+	for (auto fd : fds) {
+		if (fd >= 0) close(fd);
+	}
+}
+
+
+bool perf_counters::available() const
+{
+	for (auto fd : fds) {
+		if (fd >= 0) return true;
+	}
+	return false;
+}
+
+
+void perf_counters::start()
+{
+	for (auto fd : fds) {
+		if (fd < 0) continue;
+		ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+}
+
+
+void perf_counters::stop()
+{
+	for (auto fd : fds) {
+		if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+	}
+}
+
+
+perf_counters::values perf_counters::read() const
+{
+	values v;
+	for (int e = 0; e < events; ++e) {
+		v[e] = -1;
+		if (fds[e] < 0) continue;
+		uint64_t data[3];	// Value, time enabled, time running.
+		if (::read(fds[e], data, sizeof(data)) != sizeof(data)) continue;
+		if ((data[2] > 0) && (data[2] < data[1])) {
+			v[e] = static_cast<long>(static_cast<double>(data[0]) * data[1] / data[2]);
+		} else {
+			v[e] = data[0];
+		}
+	}
+	return v;
+}
+
+
+const char* perf_counters::name(event e)
+{
+	return counter_events[e].name;
+}
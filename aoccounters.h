@@ -0,0 +1,42 @@
+#ifndef _AOCCOUNTERS_H_
+#define _AOCCOUNTERS_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <array>
+#include <string>
+
+// Hardware performance counters of this thread, using perf_event_open(2).
+// Counters that the kernel or the CPU does not support are left closed and
+// read as -1, so the caller can carry on without them.  Only user space
+// is counted.
+class perf_counters {
+public:
+	enum event { cycles, instructions, l1d_misses, llc_misses, branch_misses, events };
+	typedef std::array<long, events> values;
+
+	perf_counters();
+	~perf_counters();
+
+	perf_counters(const perf_counters&) = delete;
+	perf_counters& operator=(const perf_counters&) = delete;
+
+	// True if at least one of the counters could be opened.
+	bool available() const;
+	// Reason why the counters are not available.
+	const std::string& error() const { return reason; }
+
+	void start();
+	void stop();
+
+	// Current counter values, scaled up if the kernel had to multiplex the counters.
+	values read() const;
+
+	static const char* name(event e);
+
+private:
+	std::array<int, events> fds;
+	std::string reason;
+};
+
+#endif /* _AOCCOUNTERS_H_ */
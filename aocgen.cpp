@@ -0,0 +1,422 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+// Synthetic puzzle input generators.  Each follows its day's grammar, and
+// the same day, scale and seed always give the same input.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "aocgen.h"
+
+typedef std::mt19937_64 rng;
+
+// Random integer in [lo, hi].
+static long rnd(rng& r, long lo, long hi)
+{
+	return std::uniform_int_distribution<long>(lo, hi)(r);
+}
+
+// True with probability p.
+static bool chance(rng& r, double p)
+{
+	return std::bernoulli_distribution(p)(r);
+}
+
+// Side of a square map that has 'scale' times the area of a side × side map.
+static int scaled_side(int side, long scale)
+{
+	return std::max(side, static_cast<int>(std::lround(side * std::sqrt(static_cast<double>(scale)))));
+}
+
+
+// Day 1: Lines of letters, digits and spelled out digits.
+static void day01(std::ostream& out, rng& r, long scale)
+{
+	static const char* words[] = { "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+	for (long n = 0; n < 1000 * scale; ++n) {
+		std::string line;
+		long length = rnd(r, 5, 40);
+		bool digit = false;
+		while (static_cast<long>(line.length()) < length) {
+			long what = rnd(r, 0, 9);
+			if (what < 2) {
+				line += '1' + rnd(r, 0, 8);
+				digit = true;
+			} else if (what < 4) {
+				line += words[rnd(r, 0, 8)];
+			} else {
+				line += 'a' + rnd(r, 0, 25);
+			}
+		}
+		// Part 1 needs at least one digit on each line.
+		if (!digit) line.insert(rnd(r, 0, line.length()), 1, '1' + rnd(r, 0, 8));
+		out << line << "\n";
+	}
+}
+
+
+// Day 2: Games with a few handfuls of red, green and blue cubes.
+static void day02(std::ostream& out, rng& r, long scale)
+{
+	std::array<std::string, 3> colors = { "red", "green", "blue" };
+	for (long game = 1; game <= 100 * scale; ++game) {
+		out << "Game " << game << ": ";
+		long handfuls = rnd(r, 1, 6);
+		for (long h = 0; h < handfuls; ++h) {
+			std::shuffle(colors.begin(), colors.end(), r);
+			long count = rnd(r, 1, 3);
+			for (long c = 0; c < count; ++c) {
+				out << rnd(r, 1, 20) << " " << colors[c] << ((c + 1 < count) ? ", " : "");
+			}
+			out << ((h + 1 < handfuls) ? "; " : "");
+		}
+		out << "\n";
+	}
+}
+
+
+// Day 3: Engine schematic, 140 columns wide and 140 × scale lines.
+static void day03(std::ostream& out, rng& r, long scale)
+{
+	static const std::string symbols = "*#+$/=%@&-";
+	const int width = 140;
+	for (long y = 0; y < 140 * scale; ++y) {
+		std::string line;
+		while (line.length() < width) {
+			size_t room = width - line.length();
+			if ((room >= 2) && chance(r, 0.15)) {
+				// A number, followed by something else than a digit.
+				long digits = std::min<long>(rnd(r, 1, 3), room - 1);
+				line += '1' + rnd(r, 0, 8);
+				for (long d = 1; d < digits; ++d) line += '0' + rnd(r, 0, 9);
+				line += chance(r, 0.1) ? symbols[rnd(r, 0, symbols.length() - 1)] : '.';
+			} else if (chance(r, 0.06)) {
+				line += chance(r, 0.4) ? '*' : symbols[rnd(r, 0, symbols.length() - 1)];
+			} else {
+				line += '.';
+			}
+		}
+		out << line << "\n";
+	}
+}
+
+
+// Day 4: Scratchcards.  Matches are mostly zero so that the number
+// of card copies in part 2 grows linearly, not exponentially.
+static void day04(std::ostream& out, rng& r, long scale)
+{
+	const long cards = 200 * scale;
+	std::vector<int> numbers(99);
+	std::iota(numbers.begin(), numbers.end(), 1);
+	for (long card = 1; card <= cards; ++card) {
+		long matches = chance(r, 0.35) ? rnd(r, 1, 4) : 0;
+		matches = std::min(matches, cards - card);
+
+		// First 10 are the winning numbers, dealt numbers are 'matches'
+		// of those and the rest from the numbers that do not win.
+		std::shuffle(numbers.begin(), numbers.end(), r);
+		std::vector<int> dealt(numbers.begin(), numbers.begin() + matches);
+		dealt.insert(dealt.end(), numbers.begin() + 10, numbers.begin() + 10 + 25 - matches);
+		std::shuffle(dealt.begin(), dealt.end(), r);
+
+		out << "Card " << std::string((card < 10) ? "  " : ((card < 100) ? " " : "")) << card << ":";
+		for (int i = 0; i < 10; ++i) out << ((numbers[i] < 10) ? "  " : " ") << numbers[i];
+		out << " |";
+		for (auto n : dealt) out << ((n < 10) ? "  " : " ") << n;
+		out << "\n";
+	}
+}
+
+
+// Day 5: Seeds, then seven maps.  Each map cuts the 32-bit number range
+// into pieces and lays them out again in a shuffled order, so source and
+// destination ranges never overlap within a map.  Seed ranges are kept
+// short enough for the brute force part 2 to finish.
+static void day05(std::ostream& out, rng& r, long scale)
+{
+	static const char* names[] = {
+		"seed-to-soil", "soil-to-fertilizer", "fertilizer-to-water", "water-to-light",
+		"light-to-temperature", "temperature-to-humidity", "humidity-to-location"
+	};
+	const long top = 1L << 32;
+
+	out << "seeds:";
+	for (long n = 0; n < 10 * scale; ++n) {
+		long length = rnd(r, 1000, 100000);
+		out << " " << rnd(r, 0, top - length) << " " << length;
+	}
+	out << "\n";
+
+	const long pieces = 30 * scale;
+	for (const auto name : names) {
+		std::set<long> cuts = { 0, top };
+		while (static_cast<long>(cuts.size()) < pieces + 1) cuts.insert(rnd(r, 1, top - 1));
+		std::vector<long> begins(cuts.begin(), std::prev(cuts.end()));
+		std::vector<long> lengths;
+		for (auto c = cuts.begin(); std::next(c) != cuts.end(); ++c) lengths.push_back(*std::next(c) - *c);
+
+		std::vector<size_t> order(begins.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::shuffle(order.begin(), order.end(), r);
+
+		// Destinations follow each other in the shuffled order.
+		std::vector<std::string> lines;
+		long dest = 0;
+		for (auto i : order) {
+			lines.push_back(std::to_string(dest) + " " + std::to_string(begins[i]) + " " + std::to_string(lengths[i]));
+			dest += lengths[i];
+		}
+		std::shuffle(lines.begin(), lines.end(), r);
+
+		out << "\n" << name << " map:\n";
+		for (const auto& l : lines) out << l << "\n";
+	}
+}
+
+
+// Day 6: Four races.  Part 2 joins the numbers into one race solved by
+// looping over the race time, so scale adds digits to the race times
+// instead of adding races: each tenfold scale adds a digit, making the
+// joined time and the loop ten times longer.  Races longer than two digits
+// are won by short presses, keeping the joined distance within 64 bits,
+// which caps the extra digits at five.
+static void day06(std::ostream& out, rng& r, long scale)
+{
+	int extra = std::min(5, static_cast<int>(std::log10(static_cast<double>(scale))));
+	std::array<long, 4> times, distances;
+	for (int i = 0; i < 4; ++i) {
+		int digits = 2 + extra / 4 + ((i < extra % 4) ? 1 : 0);
+		long low = (digits > 2) ? static_cast<long>(std::pow(10, digits - 1)) : 40;
+		long t = rnd(r, low, static_cast<long>(std::pow(10, digits)) - 1);
+		long press = rnd(r, 1, (digits > 2) ? 9 : t / 3);
+		times[i] = t;
+		distances[i] = press * (t - press);
+	}
+	out << "Time:    ";
+	for (auto t : times) { out << " "; out.width(6); out << t; }
+	out << "\nDistance:";
+	for (auto d : distances) { out << " "; out.width(6); out << d; }
+	out << "\n";
+}
+
+
+// Day 7: Camel Cards hands and bids.  Hands are unique like in the real
+// input, as the ranking of equal hands would be ambiguous, so there are at
+// most 13^5 of them.
+static void day07(std::ostream& out, rng& r, long scale)
+{
+	static const std::string labels = "23456789TJQKA";
+	const long hands = std::min(1000 * scale, 13L * 13 * 13 * 13 * 13);
+	std::set<std::string> used;
+	while (static_cast<long>(used.size()) < hands) {
+		std::string hand;
+		for (int c = 0; c < 5; ++c) hand += labels[rnd(r, 0, labels.length() - 1)];
+		if (used.insert(hand).second) out << hand << " " << rnd(r, 1, 1000) << "\n";
+	}
+}
+
+
+// Day 8: Route of random L and R instructions, and a network of six ghost
+// cycles.  Each ghost walks a chain of nodes from its xxA start to its xxZ
+// end, and the end leads back to the second node of the chain.  The chain
+// lengths are distinct primes times the route length, which is what the
+// least common multiple in part 2 relies on.  The node that the route does
+// not take is a random node.  Ghost zero is AAA to ZZZ for part 1.
+// Node labels are three characters, so the network size is capped.
+static void day08(std::ostream& out, rng& r, long scale)
+{
+	static const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+	static const std::array<long, 6> primes = { 3, 5, 7, 11, 13, 17 };
+	const long max_nodes = 36 * 36 * 34;
+	const long nodes = std::min(750 * scale, max_nodes);
+	const long prime_sum = std::accumulate(primes.begin(), primes.end(), 0L);
+	const long route_length = std::max(2L, nodes / prime_sum);
+
+	std::string route;
+	for (long i = 0; i < route_length; ++i) route += chance(r, 0.5) ? 'L' : 'R';
+
+	// Unique node labels.  Only the ghost start and end nodes end with A or Z.
+	std::set<std::string> used = { "AAA", "ZZZ" };
+	auto label = [&](char last) {
+		static const std::string middle = "BCDEFGHIJKLMNOPQRSTUVWXY0123456789";
+		for (;;) {
+			std::string s;
+			s += chars[rnd(r, 0, chars.length() - 1)];
+			s += chars[rnd(r, 0, chars.length() - 1)];
+			s += last ? last : middle[rnd(r, 0, middle.length() - 1)];
+			if (used.insert(s).second) return s;
+		}
+	};
+
+	// Ghost chains, start node first and end node last.
+	std::vector<std::vector<std::string>> chains;
+	for (size_t g = 0; g < primes.size(); ++g) {
+		std::vector<std::string> chain;
+		chain.push_back((0 == g) ? "AAA" : label('A'));
+		for (long i = 1; i < primes[g] * route_length; ++i) chain.push_back(label(0));
+		chain.push_back((0 == g) ? "ZZZ" : label('Z'));
+		chains.push_back(chain);
+	}
+	std::vector<std::string> all(used.begin(), used.end());
+
+	// Connect each node to the next one in the direction the route takes at that step.
+	std::vector<std::string> lines;
+	for (const auto& chain : chains) {
+		for (size_t i = 0; i < chain.size(); ++i) {
+			const auto& next = (i + 1 < chain.size()) ? chain[i + 1] : chain[1];
+			const auto& other = all[rnd(r, 0, all.size() - 1)];
+			bool right = ('R' == route[i % route_length]);
+			lines.push_back(chain[i] + " = (" + (right ? other : next) + ", " + (right ? next : other) + ")");
+		}
+	}
+	std::shuffle(lines.begin(), lines.end(), r);
+
+	out << route << "\n\n";
+	for (const auto& l : lines) out << l << "\n";
+}
+
+
+// Day 9: Sensor histories, each a polynomial sequence of 21 values.
+static void day09(std::ostream& out, rng& r, long scale)
+{
+	for (long n = 0; n < 200 * scale; ++n) {
+		// Initial values of the difference levels, the last level is constant.
+		long degree = rnd(r, 0, 10);
+		std::vector<long> diffs(degree + 1);
+		for (auto& d : diffs) d = rnd(r, -20, 20);
+		for (int i = 0; i < 21; ++i) {
+			out << diffs[0] << ((i < 20) ? " " : "\n");
+			for (long k = 0; k < degree; ++k) diffs[k] += diffs[k + 1];
+		}
+	}
+}
+
+
+// Day 10: A closed pipe loop among junk pipes.  The loop is the outline
+// of a random spanning tree drawn with 2×2 cell blocks for the tree nodes
+// and the edges between them: the tree has no cycles and no blocks touching
+// only at a corner, so its outline is a single loop that never touches
+// itself.  The outline runs along cell corners, and each corner becomes a
+// tile of the map.  Corners inside the tree are the enclosed tiles.
+static void day10(std::ostream& out, rng& r, long scale)
+{
+	const int side = scaled_side(140, scale);
+	const int nodes = (side - 1) / 4;		// Tree nodes on each side.
+	const int blocks = 2 * nodes - 1;		// Blocks on each side, nodes and edges between them.
+	const int cells = 2 * blocks;			// Cells on each side.
+	const int width = cells + 3;			// Corners on each side, and one tile of margin.
+
+	// Random depth-first spanning tree.
+	std::vector<bool> region(blocks * blocks, false);
+	std::vector<bool> visited(nodes * nodes, false);
+	std::vector<std::pair<int, int>> stack = { { static_cast<int>(rnd(r, 0, nodes - 1)), static_cast<int>(rnd(r, 0, nodes - 1)) } };
+	visited[stack[0].second * nodes + stack[0].first] = true;
+	region[2 * stack[0].second * blocks + 2 * stack[0].first] = true;
+	while (!stack.empty()) {
+		auto [x, y] = stack.back();
+		std::vector<std::pair<int, int>> next;
+		for (auto [dx, dy] : { std::pair{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } }) {
+			int nx = x + dx, ny = y + dy;
+			if ((nx >= 0) && (nx < nodes) && (ny >= 0) && (ny < nodes) && !visited[ny * nodes + nx]) next.push_back({ nx, ny });
+		}
+		if (next.empty()) { stack.pop_back(); continue; }
+		auto [nx, ny] = next[rnd(r, 0, next.size() - 1)];
+		visited[ny * nodes + nx] = true;
+		region[2 * ny * blocks + 2 * nx] = true;
+		region[(y + ny) * blocks + (x + nx)] = true;
+		stack.push_back({ nx, ny });
+	}
+	auto inside = [&](int x, int y) {
+		return (x >= 0) && (x < cells) && (y >= 0) && (y < cells) && region[(y / 2) * blocks + x / 2];
+	};
+
+	// Outline: corner (x, y) has an edge to the east if exactly one of the
+	// cells above and below that edge is in the region, and so on.
+	std::vector<char> map(width * width);
+	std::vector<std::pair<int, int>> loop;
+	for (int y = 0; y < width; ++y) {
+		for (int x = 0; x < width; ++x) {
+			int cx = x - 1, cy = y - 1;		// Corner coordinates.
+			bool n = (inside(cx - 1, cy - 1) != inside(cx, cy - 1));
+			bool s = (inside(cx - 1, cy) != inside(cx, cy));
+			bool w = (inside(cx - 1, cy - 1) != inside(cx - 1, cy));
+			bool e = (inside(cx, cy - 1) != inside(cx, cy));
+			char c = 0;
+			if (n && s) c = '|';
+			if (e && w) c = '-';
+			if (n && e) c = 'L';
+			if (n && w) c = 'J';
+			if (s && w) c = '7';
+			if (s && e) c = 'F';
+			if (c) loop.push_back({ x, y });
+			else c = ".|-LJ7F"[rnd(r, 0, 6)];	// Junk.
+			map[y * width + x] = c;
+		}
+	}
+
+	// Start somewhere on the loop.  Junk next to it must not connect to it,
+	// so that the start tile shape is unambiguous.
+	auto [sx, sy] = loop[rnd(r, 0, loop.size() - 1)];
+	auto connects = [&](int x, int y, const std::string& pipes) {
+		return pipes.find(map[y * width + x]) != std::string::npos;
+	};
+	bool sn = connects(sx, sy, "|LJ"), ss = connects(sx, sy, "|7F"), sw = connects(sx, sy, "-J7"), se = connects(sx, sy, "-LF");
+	if (!sn && connects(sx, sy - 1, "|7F")) map[(sy - 1) * width + sx] = '.';
+	if (!ss && connects(sx, sy + 1, "|LJ")) map[(sy + 1) * width + sx] = '.';
+	if (!sw && connects(sx - 1, sy, "-LF")) map[sy * width + sx - 1] = '.';
+	if (!se && connects(sx + 1, sy, "-J7")) map[sy * width + sx + 1] = '.';
+	map[sy * width + sx] = 'S';
+
+	for (int y = 0; y < width; ++y) {
+		out << std::string(&map[y * width], width) << "\n";
+	}
+}
+
+
+// Day 11: Galaxy image with some empty lines and columns.
+static void day11(std::ostream& out, rng& r, long scale)
+{
+	const int side = scaled_side(140, scale);
+	std::vector<bool> empty_column(side);
+	for (int x = 0; x < side; ++x) empty_column[x] = chance(r, 0.05);
+	for (int y = 0; y < side; ++y) {
+		std::string line(side, '.');
+		if (!chance(r, 0.05)) {
+			for (int x = 0; x < side; ++x) {
+				if (!empty_column[x] && chance(r, 0.022)) line[x] = '#';
+			}
+		}
+		out << line << "\n";
+	}
+}
+
+
+// Generators for each day.
+typedef void (*generator)(std::ostream&, rng&, long);
+static const std::map<int, generator> generators = {
+	{1, day01}, {2, day02}, {3, day03}, {4, day04}, {5, day05}, {6, day06}, {7, day07},
+	{8, day08}, {9, day09}, {10, day10}, {11, day11}
+};
+
+
+bool generate_input(std::ostream& out, int day, long scale, unsigned long seed)
+{
+	auto g = generators.find(day);
+	if (g == generators.end()) return false;
+	if (scale < 1) scale = 1;
+
+	// Each day has its own stream of random numbers from the same seed.
+	rng r(seed * 100 + day);
+	g->second(out, r, scale);
+	return true;
+}
@@ -0,0 +1,16 @@
+#ifndef _AOCGEN_H_
+#define _AOCGEN_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <iostream>
+
+// Default seed, so that generated inputs are reproducible.
+constexpr unsigned long default_seed = 2023;
+
+// Write a synthetic puzzle input for the day.  Scale 1 is roughly the size of
+// the real puzzle input, scale 100 is a hundred times that, and so on.
+// Returns false if there is no generator for the day.
+bool generate_input(std::ostream& out, int day, long scale, unsigned long seed = default_seed);
+
+#endif /* _AOCGEN_H_ */
@@ -0,0 +1,34 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+// Synthetic puzzle input generator.
+//
+//	aocgen <day> [scale] [seed]
+//
+// Writes a valid puzzle input for the day to standard output.  Scale 1
+// is roughly the size of the real puzzle input, scale 100 is a hundred
+// times that, and so on.  The same seed always gives the same input.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "aocgen.h"
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <day> [scale] [seed]" << std::endl;
+		return 1;
+	}
+	int day = atoi(argv[1]);
+	long scale = (argc > 2) ? atol(argv[2]) : 1;
+	unsigned long seed = (argc > 3) ? strtoul(argv[3], nullptr, 10) : default_seed;
+
+	std::ios::sync_with_stdio(false);
+	if (!generate_input(std::cout, day, scale, seed)) {
+		std::cerr << "No generator for day " << day << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
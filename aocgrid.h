@@ -0,0 +1,183 @@
+#ifndef _AOCGRID_H_
+#define _AOCGRID_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "aocarena.h"
+#include "aocinput.h"
+
+// Iterates over cells that are a fixed number of cells apart, eg. a column.
+template <typename T>
+class stride_iterator {
+public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = std::remove_const_t<T>;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T*;
+	using reference = T&;
+
+	stride_iterator() = default;
+	stride_iterator(T* p, std::ptrdiff_t stride) : p(p), stride(stride) {}
+
+	reference operator*() const { return *p; }
+	pointer operator->() const { return p; }
+	stride_iterator& operator++() { p += stride; return *this; }
+	stride_iterator operator++(int) { auto it = *this; p += stride; return it; }
+
+	friend bool operator==(const stride_iterator& lhs, const stride_iterator& rhs) { return lhs.p == rhs.p; }
+
+private:
+	T* p = nullptr;
+	std::ptrdiff_t stride = 1;
+};
+
+// Iterates over the cells around a center cell, given as offsets from it.
+template <typename T>
+class offset_iterator {
+public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = std::remove_const_t<T>;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T*;
+	using reference = T&;
+
+	offset_iterator() = default;
+	offset_iterator(T* center, const std::ptrdiff_t* offset) : center(center), offset(offset) {}
+
+	reference operator*() const { return center[*offset]; }
+	pointer operator->() const { return &center[*offset]; }
+	offset_iterator& operator++() { ++offset; return *this; }
+	offset_iterator operator++(int) { auto it = *this; ++offset; return it; }
+
+	friend bool operator==(const offset_iterator& lhs, const offset_iterator& rhs) { return lhs.offset == rhs.offset; }
+
+private:
+	T* center = nullptr;
+	const std::ptrdiff_t* offset = nullptr;
+};
+
+// Begin and end of the cells of a column or the neighbours of a cell.
+template <typename Iterator>
+struct grid_range {
+	Iterator first, last;
+	Iterator begin() const { return first; }
+	Iterator end() const { return last; }
+};
+
+
+// Row-major 2D grid with a border of sentinel cells around it.
+// Cells are addressed with x in [0, width) and y in [0, height), and the
+// border adds one cell in each direction, so the neighbours of any cell can
+// be read without bounds checks.  Cells can also be addressed by index, and
+// moved around with offsets: index(x, y) + offset(dx, dy).
+// Cells are allocated from the day resource.
+//
+//	auto grid = Grid<char>::load(input, '.');
+//	for (char c : grid.neighbours(x, y)) { ... }
+template <typename T>
+class Grid {
+public:
+	explicit Grid(std::pmr::memory_resource* resource = day_resource()) : cells(resource) {}
+
+	Grid(int width, int height, const T& fill = T(), const T& border = T(), std::pmr::memory_resource* resource = day_resource())
+		: w(width), h(height), stride(width + 2), cells(static_cast<size_t>(width + 2) * (height + 2), border, resource)
+	{
+		for (int y = 0; y < h; ++y) std::fill_n(&cells[index(0, y)], w, fill);
+		set_offsets();
+	}
+
+	Grid(const Grid& other, std::pmr::memory_resource* resource = day_resource())
+		: w(other.w), h(other.h), stride(other.stride), around(other.around), cardinal(other.cardinal), cells(other.cells, resource) {}
+	Grid(Grid&& other) = default;
+	Grid& operator=(const Grid& other) = default;
+	Grid& operator=(Grid&& other) = default;
+
+	// Load a grid from text with one row per line, converting each character
+	// into a cell.  The width is the length of the first line, and cells
+	// missing from shorter lines are left as the border.
+	template <typename Convert>
+	static Grid load(std::string_view text, const T& border, Convert convert, std::pmr::memory_resource* resource = day_resource())
+	{
+		size_t width = std::min(text.find('\n'), text.size());
+		size_t height = std::count(text.begin(), text.end(), '\n') + ((text.empty() || ('\n' == text.back())) ? 0 : 1);
+		Grid grid(width, height, border, border, resource);
+		int y = 0;
+		for (auto line : lines(text)) {
+			T* row = &grid.cells[grid.index(0, y++)];
+			std::transform(line.begin(), line.begin() + std::min(line.size(), width), row, convert);
+		}
+		return grid;
+	}
+
+	// Load a grid of characters, or of cells constructed from them.
+	static Grid load(std::string_view text, const T& border, std::pmr::memory_resource* resource = day_resource())
+	{
+		return load(text, border, [](char c) { return T(c); }, resource);
+	}
+
+	int width() const { return w; }
+	int height() const { return h; }
+	bool contains(int x, int y) const { return (x >= 0) && (x < w) && (y >= 0) && (y < h); }
+
+	T& operator()(int x, int y) { return cells[index(x, y)]; }
+	const T& operator()(int x, int y) const { return cells[index(x, y)]; }
+
+	// Cells by index.  The border cells have indexes too.
+	size_t index(int x, int y) const { return static_cast<size_t>(y + 1) * stride + (x + 1); }
+	std::ptrdiff_t offset(int dx, int dy) const { return static_cast<std::ptrdiff_t>(dy) * stride + dx; }
+	int x_of(size_t i) const { return static_cast<int>(i % stride) - 1; }
+	int y_of(size_t i) const { return static_cast<int>(i / stride) - 1; }
+	T& operator[](size_t i) { return cells[i]; }
+	const T& operator[](size_t i) const { return cells[i]; }
+
+	// Cells of a row, left to right.
+	std::span<T> row(int y) { return { &cells[index(0, y)], static_cast<size_t>(w) }; }
+	std::span<const T> row(int y) const { return { &cells[index(0, y)], static_cast<size_t>(w) }; }
+
+	// Cells of a column, top to bottom.
+	grid_range<stride_iterator<T>> column(int x) {
+		return { { &cells[index(x, 0)], stride }, { &cells[index(x, h)], stride } };
+	}
+	grid_range<stride_iterator<const T>> column(int x) const {
+		return { { &cells[index(x, 0)], stride }, { &cells[index(x, h)], stride } };
+	}
+
+	// The eight cells around a cell, clockwise from the north, or only the
+	// four in the cardinal directions north, east, south and west.
+	grid_range<offset_iterator<T>> neighbours(int x, int y) { return cells_around(&cells[index(x, y)], around); }
+	grid_range<offset_iterator<const T>> neighbours(int x, int y) const { return cells_around(&cells[index(x, y)], around); }
+	grid_range<offset_iterator<T>> adjacent(int x, int y) { return cells_around(&cells[index(x, y)], cardinal); }
+	grid_range<offset_iterator<const T>> adjacent(int x, int y) const { return cells_around(&cells[index(x, y)], cardinal); }
+
+private:
+	void set_offsets() {
+		around = {
+			offset(0, -1), offset(1, -1), offset(1, 0), offset(1, 1),
+			offset(0, 1), offset(-1, 1), offset(-1, 0), offset(-1, -1)
+		};
+		cardinal = { offset(0, -1), offset(1, 0), offset(0, 1), offset(-1, 0) };
+	}
+
+	template <typename C, size_t N>
+	static grid_range<offset_iterator<C>> cells_around(C* center, const std::array<std::ptrdiff_t, N>& offsets) {
+		return { { center, offsets.data() }, { center, offsets.data() + N } };
+	}
+
+	int w = 0;
+	int h = 0;
+	std::ptrdiff_t stride = 2;
+	std::array<std::ptrdiff_t, 8> around {};	// Offsets of the eight neighbours.
+	std::array<std::ptrdiff_t, 4> cardinal {};	// Offsets of the four adjacent cells.
+	std::pmr::vector<T> cells;
+};
+
+#endif /* _AOCGRID_H_ */
@@ -0,0 +1,51 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "aocinput.h"
+
+
+mapped_input::mapped_input(const std::string& filename)
+{
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) return;
+	open = true;
+
+	struct stat st;
+	if ((0 == fstat(fd, &st)) && S_ISREG(st.st_mode)) {
+		size = st.st_size;
+		if (0 == size) {
+			// Nothing to map, view() is just empty.
+			::close(fd);
+			return;
+		}
+		void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+		if (MAP_FAILED != p) {
+			madvise(p, size, MADV_SEQUENTIAL);
+			data = static_cast<const char*>(p);
+			mapped = true;
+			::close(fd);
+			return;
+		}
+	}
+
+	// Not a regular file or mapping failed, read the old-fashioned way.
+	char chunk[65536];
+	for (ssize_t n; (n = ::read(fd, chunk, sizeof(chunk))) > 0; ) {
+		buffer.append(chunk, n);
+	}
+	data = buffer.data();
+	size = buffer.size();
+	::close(fd);
+}
+
+
+mapped_input::~mapped_input()
+{
+	if (mapped) munmap(const_cast<char*>(data), size);
+}
@@ -0,0 +1,126 @@
+#ifndef _AOCINPUT_H_
+#define _AOCINPUT_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+// Puzzle input file mapped read-only into memory.
+// Files that cannot be mapped (pipes, character devices) are read
+// into a buffer instead, so view() works the same for both.
+class mapped_input {
+public:
+	explicit mapped_input(const std::string& filename);
+	~mapped_input();
+
+	mapped_input(const mapped_input&) = delete;
+	mapped_input& operator=(const mapped_input&) = delete;
+
+	bool is_open() const { return open; }
+	std::string_view view() const { return { data, size }; }
+
+private:
+	const char* data = nullptr;
+	size_t size = 0;
+	bool open = false;
+	bool mapped = false;
+	std::string buffer;		// Used when the file could not be mapped.
+};
+
+
+// 64-bit FNV-1a hash of the puzzle input contents.
+inline uint64_t input_hash(std::string_view input)
+{
+	uint64_t h = 0xcbf29ce484222325;
+	for (unsigned char c : input) {
+		h ^= c;
+		h *= 0x100000001b3;
+	}
+	return h;
+}
+
+
+// Iterates over delimiter separated records of the input without copying.
+// Like std::getline(), the final delimiter does not produce an empty record.
+//
+//	for (auto line : records(input)) { ... }
+class records {
+public:
+	explicit records(std::string_view input, char delimiter = '\n') : input(input), delimiter(delimiter) {}
+
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const std::string_view*;
+		using reference = const std::string_view&;
+
+		iterator() = default;
+		iterator(std::string_view input, char delimiter, size_t pos) : input(input), delimiter(delimiter), pos(pos) { find_end(); }
+
+		reference operator*() const { return record; }
+		pointer operator->() const { return &record; }
+		iterator& operator++() { pos = end + 1; find_end(); return *this; }
+		iterator operator++(int) { auto it = *this; ++(*this); return it; }
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs) { return lhs.pos == rhs.pos; }
+
+	private:
+		// Locate the end of the current record.
+		void find_end() {
+			if (pos >= input.size()) { pos = input.size(); record = {}; return; }
+			end = input.find(delimiter, pos);
+			if (std::string_view::npos == end) end = input.size();
+			record = input.substr(pos, end - pos);
+		}
+
+		std::string_view input;
+		char delimiter = '\n';
+		size_t pos = 0;
+		size_t end = 0;
+		std::string_view record;
+	};
+
+	iterator begin() const { return { input, delimiter, 0 }; }
+	iterator end() const { return { input, delimiter, input.size() }; }
+
+private:
+	std::string_view input;
+	char delimiter;
+};
+
+// Lines of the input, without the line feeds.
+inline records lines(std::string_view input) { return records(input, '\n'); }
+
+
+// Read-only stream buffer over a block of memory.
+// Lets the std::istream based day functions read input that is already
+// in memory without copying it into a stringstream.
+struct membuf : std::streambuf {
+	membuf(std::string_view input) {
+		char* b = const_cast<char*>(input.data());
+		setg(b, b, b + input.size());
+	}
+
+	// Needed for rewinding with seekg(0), some solutions might do that.
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+		if (which & std::ios_base::out) return pos_type(off_type(-1));
+		char* pos = (dir == std::ios_base::beg) ? eback() : ((dir == std::ios_base::end) ? egptr() : gptr());
+		pos += off;
+		if ((pos < eback()) || (pos > egptr())) return pos_type(off_type(-1));
+		setg(eback(), pos, egptr());
+		return pos_type(pos - eback());
+	}
+
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+		return seekoff(off_type(pos), std::ios_base::beg, which);
+	}
+};
+
+#endif /* _AOCINPUT_H_ */
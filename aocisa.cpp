@@ -0,0 +1,43 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <string>
+
+#include "aocisa.h"
+
+static const char* const isa_names[] = { "scalar", "sse4.2", "avx2", "avx512" };
+
+
+isa detected_isa()
+{
+	__builtin_cpu_init();	// Also called before main, from the initialiser below.
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return isa::avx512;
+	if (__builtin_cpu_supports("avx2")) return isa::avx2;
+	if (__builtin_cpu_supports("sse4.2")) return isa::sse42;
+	return isa::scalar;
+}
+
+
+static isa selected = detected_isa();
+
+isa current_isa()
+{
+	return selected;
+}
+
+
+bool select_isa(const std::string& name)
+{
+	for (int level = 0; level <= static_cast<int>(detected_isa()); ++level) {
+		if (name == isa_names[level]) {
+			selected = static_cast<isa>(level);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+const char* isa_name(isa level)
+{
+	return isa_names[static_cast<int>(level)];
+}
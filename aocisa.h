@@ -0,0 +1,79 @@
+#ifndef _AOCISA_H_
+#define _AOCISA_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <cstdint>
+#include <string>
+
+#include <immintrin.h>
+
+// Runtime choice of the vectorised kernels.  The program is built for the
+// baseline x86-64, and each kernel has variants compiled for wider
+// instruction sets with target attributes.  The widest one the CPU has is
+// chosen at startup, or a narrower one with --isa to compare them.
+
+// Instruction set levels, each including the ones before it.
+enum class isa { scalar, sse42, avx2, avx512 };
+
+// Widest level this CPU has.  AVX-512 needs the F and BW extensions.
+isa detected_isa();
+
+// Level of the kernels in use.
+isa current_isa();
+
+// Use the kernels of the named level, one of "scalar", "sse4.2", "avx2" or
+// "avx512".  Returns false if the name is unknown or the CPU does not have
+// the level.  Must be called before the day solutions run.
+bool select_isa(const std::string& name);
+
+const char* isa_name(isa level);
+
+
+// Variants of a kernel by level, resolved to the widest one not above the
+// current level.  Missing variants are nullptr, and the scalar one must be
+// given.  Look the kernel up once outside of hot loops.
+//
+//	static const isa_dispatch<long(const char*, size_t)> kernel { scan_scalar, nullptr, scan_avx2, scan_avx512 };
+//	auto scan = kernel.get();
+template <typename F>
+class isa_dispatch {
+public:
+	isa_dispatch(F* scalar, F* sse42, F* avx2, F* avx512) : variants { scalar, sse42, avx2, avx512 } {}
+
+	F* get() const {
+		for (int level = static_cast<int>(current_isa()); level > 0; --level) {
+			if (variants[level]) return variants[level];
+		}
+		return variants[0];
+	}
+
+private:
+	F* variants[4];
+};
+
+
+// Bit masks of the decimal digits in 16, 32 or 64 bytes at p, one bit per
+// byte, for the kernels of each level.
+__attribute__((target("sse4.2")))
+inline uint64_t digit_mask16(const char* p)
+{
+	__m128i v = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+	return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(9)), v)));
+}
+
+__attribute__((target("avx2")))
+inline uint64_t digit_mask32(const char* p)
+{
+	__m256i v = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), _mm256_set1_epi8('0'));
+	return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(9)), v)));
+}
+
+__attribute__((target("avx512f,avx512bw")))
+inline uint64_t digit_mask64(const char* p)
+{
+	__m512i v = _mm512_sub_epi8(_mm512_loadu_si512(p), _mm512_set1_epi8('0'));
+	return _mm512_cmple_epu8_mask(v, _mm512_set1_epi8(9));
+}
+
+#endif /* _AOCISA_H_ */
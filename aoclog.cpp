@@ -0,0 +1,82 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+
+#include "aoclog.h"
+
+
+// Lines waiting for the writer thread.  The sink is never destroyed, as
+// the writer thread may still wait on it when the program exits.
+struct log_sink {
+	std::mutex mutex;
+	std::condition_variable pending_lines;
+	std::condition_variable written;
+	std::string pending;
+	bool writing = false;
+	bool started = false;
+};
+
+static log_sink& sink = *new log_sink;
+
+
+// Write the pending lines in batches, one flush per batch.
+static void writer()
+{
+	std::unique_lock<std::mutex> lock(sink.mutex);
+	for (;;) {
+		sink.pending_lines.wait(lock, []() { return !sink.pending.empty(); });
+		std::string batch;
+		std::swap(batch, sink.pending);
+		sink.writing = true;
+		lock.unlock();
+		std::cout.write(batch.data(), batch.size()).flush();
+		lock.lock();
+		sink.writing = false;
+		sink.written.notify_all();
+	}
+}
+
+
+// The writer thread does not exist in a forked child, so the child starts
+// its own when it logs.  Lines pending at the fork are the parent's to write.
+static void before_fork() { sink.mutex.lock(); }
+static void after_fork_parent() { sink.mutex.unlock(); }
+static void after_fork_child()
+{
+	sink.pending.clear();
+	sink.writing = false;
+	sink.started = false;
+	sink.mutex.unlock();
+}
+
+
+log_line::~log_line()
+{
+	std::lock_guard<std::mutex> lock(sink.mutex);
+	if (!sink.started) {
+		static std::once_flag registered;
+		std::call_once(registered, []() {
+			pthread_atfork(before_fork, after_fork_parent, after_fork_child);
+			std::atexit(log_flush);
+		});
+		std::thread(writer).detach();
+		sink.started = true;
+	}
+	sink.pending += str();
+	sink.pending += '\n';
+	sink.pending_lines.notify_one();
+}
+
+
+void log_flush()
+{
+	std::unique_lock<std::mutex> lock(sink.mutex);
+	sink.written.wait(lock, []() { return sink.pending.empty() && !sink.writing; });
+}
@@ -0,0 +1,45 @@
+#ifndef _AOCLOG_H_
+#define _AOCLOG_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <sstream>
+#include <string>
+
+#include "aoc.h"
+
+// Leveled debug output of the day solutions.  Summaries and per input line
+// output are at the debug level, per step output of the inner loops at the
+// trace level.  Levels above AOC_LOG_LEVEL are compiled out: the check is a
+// constant false, and the message code is removed with it.  The default
+// build has the debug level, switched on at run time with the debug
+// argument, and 'make LOGLEVEL=2' builds the trace level in too.
+//
+//	if (log_debug()) log_line() << "Sum: " << sum;
+//
+// Lines are written to standard output by a background thread, so the day
+// solution does not wait for the terminal.
+
+#ifndef AOC_LOG_LEVEL
+#define AOC_LOG_LEVEL 1
+#endif
+
+constexpr int log_level_debug = 1;
+constexpr int log_level_trace = 2;
+
+inline bool log_debug() { return (AOC_LOG_LEVEL >= log_level_debug) && debug; }
+inline bool log_trace() { return (AOC_LOG_LEVEL >= log_level_trace) && debug; }
+
+// One line of output, given to the writer thread when it goes out of scope.
+// No newline at the end.
+class log_line : public std::ostringstream {
+public:
+	log_line() = default;
+	~log_line();
+};
+
+// Wait until the lines logged so far are written.  Called before other
+// output, so that the output stays in order.
+void log_flush();
+
+#endif /* _AOCLOG_H_ */
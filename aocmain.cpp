@@ -1,12 +1,28 @@
 // Advent of Code 2023 Solutions by Arttu Kärpinlehto
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <sstream>
 
 #include "aoc.h"
+#include "aocarena.h"
+#include "aocbench.h"
+#include "aoccache.h"
+#include "aocinput.h"
+#include "aocisa.h"
+#include "aoclog.h"
+#include "aocmemory.h"
+#include "aocprofile.h"
+#include "aocserial.h"
+#include "aocserve.h"
+#include "aoctrace.h"
+#include "aocvalidate.h"
 
 // Global flags.
 bool debug = false;
@@ -19,38 +35,90 @@ std::map<int, dayfunction> day_functions = {
 	{8, day08}, {9, day09}, {10, day10}, {11, day11}
 };
 
+// Add day solutions split into parse and solve steps in this map.
+// These are used when the puzzle input is read from memory.
+// Days that can read the input one line at a time also give their
+// std::istream function for streaming.
+std::map<int, daysolver> day_solvers = {
+	{1, {day01_parse, day01_part1, day01_part2, day01}},
+	{2, {day02_parse, day02_part1, day02_part2, day02}},
+	{3, {day03_parse, day03_part1, day03_part2}},
+	{4, {day04_parse, day04_part1, day04_part2, day04}},
+	{5, {day05_parse, day05_part1, day05_part2, nullptr, day05_save, day05_load}},
+	{6, {day06_parse, day06_part1, day06_part2}},
+	{7, {day07_parse, day07_part1, day07_part2, day07, day07_save, day07_load}},
+	{8, {day08_parse, day08_part1, day08_part2}},
+	{9, {day09_parse, day09_part1, day09_part2, day09, day09_save, day09_load}},
+	{10, {day10_parse, day10_part1, day10_part2}},
+	{11, {day11_parse, day11_part1, day11_part2, nullptr, day11_save, day11_load}}
+};
 
-// AoC main.
-int main(int argc, char* argv[])
+// Add alternative engines of a day here, the reference engine first.
+// Validate mode checks that the others agree with it.
+std::map<int, std::vector<day_engine>> day_engines = {
+	{3, {{"bounding box", day03_box_part1, day03_box_part2}, {"grid", day03_part1, day03_part2}}},
+	{5, {{"brute force", day05_brute_part1, day05_brute_part2}, {"range split", day05_part1, day05_part2}, {"vector scan", day05_vector_part1, day05_vector_part2}}},
+	{6, {{"loop", day06_loop_part1, day06_loop_part2}, {"roots", day06_part1, day06_part2}}},
+	{11, {{"galaxy pairs", day11_pairs_part1, day11_pairs_part2}, {"axis sums", day11_part1, day11_part2}}}
+};
+
+
+// Puzzle input file should be named "dayNN-input.txt".
+std::string input_filename(int day)
 {
-	int AoC_year = 2023;
-	int AoC_day = 0;
-	int AoC_part = 0;
+	std::stringstream filename;
+	filename << "inputs/day" << std::string((day < 10) ? "0" : "") << day << "-input.txt";
+	return filename.str();
+}
 
-	// Argument handling.
-	if (argc > 2) {
-		int day = atoi(argv[1]);
-		if ((1 <= day) && (day <= 25)) {
-			AoC_day = day;
-		}
 
-		int part = atoi(argv[2]);
-		if (part > 0) {
-			AoC_part = part;
-		}
+// Parse a text puzzle input and write its parsed state in the binary format.
+// Returns the process exit code.
+int convert(int day, const std::string& from, const std::string& to)
+{
+	auto f = day_solvers.find(day);
+	if ((f == day_solvers.end()) || (nullptr == f->second.save)) {
+		std::cerr << "No binary format for day " << day << std::endl;
+		return 1;
+	}
+	mapped_input input(from);
+	if (!input.is_open()) {
+		std::cerr << "Cannot open " << from << std::endl;
+		return 1;
+	}
 
-		if (argc > 3) {
-			if (std::string(argv[3]) == "debug") {
-				debug = true;
-			}
-		}
+	std::string out;
+	write_binary_header(out, day);
+	try {
+		f->second.save(*f->second.parse(input.view()), out);
+	} catch (const char* e) {
+		std::cerr << from << ": " << e << std::endl;
+		return 1;
+	} catch (const std::exception& e) {
+		std::cerr << from << ": " << e.what() << std::endl;
+		return 1;
+	}
+
+	std::ofstream file(to, std::ios::binary);
+	if (!file.write(out.data(), out.size())) {
+		std::cerr << "Cannot write " << to << std::endl;
+		return 1;
 	}
+	std::cout << from << " (" << input.view().size() << " bytes) -> " << to << " (" << out.size() << " bytes)" << std::endl;
+	return 0;
+}
+
 
-	// Title banner, with optional colours.
-	int col = AoC_part;
+// Title banner, with optional colours.
+void banner(int year, int day, int part)
+{
+	int col = part;
 	std::stringstream header;
 	std::string blink;
-	header << "\n*** Advent of Code " << AoC_year << " Day " << AoC_day << ", Part " << AoC_part << " ***\n";
+	header << "\n*** Advent of Code " << year << " Day " << day;
+	if (part > 0) header << ", Part " << part;
+	else col = 1;
+	header << " ***\n";
 	if (use_colors) {
 		std::cout << "\x1B[1m";
 		for (auto c : header.str()) {
@@ -65,33 +133,370 @@ int main(int argc, char* argv[])
 	} else {
 		std::cout << header.str() << std::endl;
 	}
+}
+
+
+// AoC main.
+int main(int argc, char* argv[])
+{
+	int AoC_year = 2023;
+	int AoC_day = 0;
+	int AoC_part = 0;
+
+	// Vector kernels of an instruction set level other than the widest one
+	// of the CPU: --isa <level> in any mode, taken out before the modes see
+	// the arguments.
+	std::vector<char*> arguments;
+	for (int i = 0; i < argc; ++i) {
+		if ((std::string(argv[i]) == "--isa") && (i + 1 < argc)) {
+			if (!select_isa(argv[++i])) {
+				std::cerr << "Instruction set " << argv[i] << " is not available, this CPU has scalar up to "
+					<< isa_name(detected_isa()) << std::endl;
+				return 1;
+			}
+		} else {
+			arguments.push_back(argv[i]);
+		}
+	}
+	argc = arguments.size();
+	arguments.push_back(nullptr);
+	argv = arguments.data();
 
-	// Input file and day solution function invocation.
-	std::ifstream puzzle_input;
-	auto f = day_functions.find(AoC_day);
-	long result = 0;
-	if (f != day_functions.end()) {
-		// Puzzle input file should be named "dayNN-input.txt".
-		std::stringstream filename;
-		filename << "inputs/day" << std::string((AoC_day < 10) ? "0" : "") << AoC_day << "-input.txt";
+	// Run-all mode: aoc2023 all
+	if ((argc > 1) && (std::string(argv[1]) == "all")) {
+		std::cout << "\n*** Advent of Code " << AoC_year << " ***\n" << std::endl;
+		return run_all();
+	}
+
+	// Batch mode: aoc2023 batch <day> <part> <dir>
+	if ((argc > 1) && (std::string(argv[1]) == "batch")) {
+		if ((argc < 5) || (atoi(argv[3]) < 1) || (atoi(argv[3]) > 2)) {
+			std::cerr << "Usage: " << argv[0] << " batch <day> <part> <dir>" << std::endl;
+			return 1;
+		}
+		std::ios::sync_with_stdio(false);
+		return batch(atoi(argv[2]), atoi(argv[3]), argv[4]);
+	}
+
+	// Binary input conversion: aoc2023 convert <day> [input] [output]
+	if ((argc > 1) && (std::string(argv[1]) == "convert")) {
+		int day = (argc > 2) ? atoi(argv[2]) : 0;
+		if ((argc < 3) || (day < 1)) {
+			std::cerr << "Usage: " << argv[0] << " convert <day> [input] [output]" << std::endl;
+			return 1;
+		}
+		std::string from = (argc > 3) ? argv[3] : input_filename(day);
+		std::string to = (argc > 4) ? argv[4] : from.substr(0, from.rfind(".txt")) + ".bin";
+		return convert(day, from, to);
+	}
+
+	// Cache maintenance: aoc2023 cache [stats|clear]
+	if ((argc > 1) && (std::string(argv[1]) == "cache")) {
+		return cache_command(std::vector<std::string>(argv + 2, argv + argc));
+	}
+
+	// Server mode: aoc2023 serve --socket <path> [--warm N] [--connections N]
+	if ((argc > 1) && (std::string(argv[1]) == "serve")) {
+		serve_options options;
+		bool usage = false;
+		for (int i = 2; i < argc; ++i) {
+			std::string arg = argv[i];
+			if ((arg == "--socket") && (i + 1 < argc)) options.socket = argv[++i];
+			else if ((arg == "--warm") && (i + 1 < argc)) options.warm_entries = std::max(0, atoi(argv[++i]));
+			else if ((arg == "--connections") && (i + 1 < argc)) options.max_connections = std::max(1, atoi(argv[++i]));
+			else usage = true;
+		}
+		if (usage || options.socket.empty()) {
+			std::cerr << "Usage: " << argv[0] << " serve --socket <path> [--warm entries] [--connections limit]" << std::endl;
+			return 1;
+		}
+		return serve(options);
+	}
 
+	// Validate mode: aoc2023 validate [day] [options]
+	if ((argc > 1) && (std::string(argv[1]) == "validate")) {
+		validate_options options;
+		int day = 0;
+		for (int i = 2; i < argc; ++i) {
+			std::string arg = argv[i];
+			if ((arg == "--seeds") && (i + 1 < argc)) options.seeds = std::max(1, atoi(argv[++i]));
+			else if ((arg == "--max-scale") && (i + 1 < argc)) options.max_scale = std::max(1L, atol(argv[++i]));
+			else if ((arg == "--budget") && (i + 1 < argc)) options.budget = atof(argv[++i]);
+			else if (atoi(arg.c_str()) > 0) day = atoi(arg.c_str());
+			else {
+				std::cerr << "Usage: " << argv[0] << " validate [day] [--seeds N] [--max-scale S] [--budget seconds]" << std::endl;
+				return 1;
+			}
+		}
+		std::cout << "\n*** Advent of Code " << AoC_year << " ***\n" << std::endl;
+		return validate(day, options);
+	}
+
+	// Benchmark mode: aoc2023 bench <day> <part> [iterations] [options]
+	if ((argc > 1) && (std::string(argv[1]) == "bench")) {
+		bench_options options;
+		std::string input_option;
+		std::vector<std::string> args;
+		for (int i = 2; i < argc; ++i) {
+			std::string arg = argv[i];
+			if (arg == "--counters") options.counters = true;
+			else if (arg == "--huge-pages") options.huge_pages = true;
+			else if ((arg == "--input") && (i + 1 < argc)) input_option = argv[++i];
+			else if ((arg == "--json") && (i + 1 < argc)) options.json = argv[++i];
+			else if ((arg == "--csv") && (i + 1 < argc)) options.csv = argv[++i];
+			else if ((arg == "--compare") && (i + 1 < argc)) options.compare = argv[++i];
+			else if ((arg == "--threshold") && (i + 1 < argc)) options.threshold = atof(argv[++i]);
+			else args.push_back(arg);
+		}
+		if (args.size() < 2) {
+			std::cerr << "Usage: " << argv[0] << " bench <day> <part> [iterations] [--input file|-] [--counters] [--huge-pages]"
+				<< " [--json out.json] [--csv out.csv] [--compare baseline.json [--threshold percent]]" << std::endl;
+			return 1;
+		}
+		AoC_day = atoi(args[0].c_str());
+		AoC_part = atoi(args[1].c_str());
+		if (args.size() > 2) options.iterations = std::max(1, atoi(args[2].c_str()));
+
+		banner(AoC_year, AoC_day, AoC_part);
+		// Standard input is read into memory once, like any file that cannot be mapped.
+		std::string filename = input_option.empty() ? input_filename(AoC_day) : input_option;
+		return bench(AoC_day, AoC_part, options, ("-" == filename) ? "/dev/stdin" : filename);
+	}
+
+	// Argument handling.  Without a part, both parts are solved.
+	// Puzzle input is read from the given file, or standard input with "-".
+	std::string input_option;
+	bool huge_pages = false;
+	bool use_cache = true;
+	std::string trace_option;
+	bool memory = false;
+	std::string profile_option;
+	std::vector<std::string> args;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if ((arg == "--input") && (i + 1 < argc)) input_option = argv[++i];
+		else if (arg == "--huge-pages") huge_pages = true;
+		else if (arg == "--no-cache") use_cache = false;
+		else if (arg == "--memory") memory = true;
+		else if ((arg == "--trace") && (i + 1 < argc)) trace_option = argv[++i];
+		else if ((arg == "--profile") && (i + 1 < argc)) profile_option = argv[++i];
+		else args.push_back(arg);
+	}
+	if (args.size() > 0) {
+		int day = atoi(args[0].c_str());
+		if ((1 <= day) && (day <= 25)) {
+			AoC_day = day;
+		}
+	}
+	if (args.size() > 1) {
+		int part = atoi(args[1].c_str());
+		if (part > 0) {
+			AoC_part = part;
+		}
+
+		if (args.size() > 2) {
+			if (args[2] == "debug") {
+				debug = true;
+			}
+		}
+	}
+
+	banner(AoC_year, AoC_day, AoC_part);
+
+	// Trace spans and profile samples are written when the day is done.
+	tracing = !trace_option.empty();
+	if (!profile_option.empty() && !start_profile()) {
+		std::cerr << "Cannot start the profiler" << std::endl;
+		return 1;
+	}
+	auto finished = [&](int status) {
+		log_flush();
+		if (tracing && !write_trace(trace_option)) {
+			std::cerr << "Cannot write " << trace_option << std::endl;
+			return 1;
+		}
+		long samples = 0;
+		if (!profile_option.empty()) {
+			if (!write_profile(profile_option, samples)) {
+				std::cerr << "Cannot write " << profile_option << std::endl;
+				return 1;
+			}
+			std::cout << "Profile: " << samples << " samples in " << profile_option << std::endl;
+		}
+		return status;
+	};
+
+	// Allocations of each day function call, counted from here on.  Memory
+	// from an arena is given separately, as it does not go through new.
+	counting_allocations = memory;
+	auto memory_usage = [&](const allocation_counters& before, long arena_bytes) {
+		auto after = allocation_snapshot();
+		std::string usage = std::to_string(after.allocations - before.allocations) + " allocations, "
+			+ std::to_string(after.bytes - before.bytes) + " bytes, peak live "
+			+ std::to_string(after.peak - before.live) + " bytes";
+		if (arena_bytes >= 0) usage += ", arena " + std::to_string(arena_bytes) + " bytes";
+		return usage;
+	};
+	auto print_memory = [&](const std::string& what, const std::string& usage) {
 		if (use_colors) std::cout << "\x1B[34m";
-		std::cout << "Puzzle input: " << filename.str() << std::endl;
+		std::cout << "Memory " << what << ": " << usage << std::endl;
 		if (use_colors) std::cout << "\x1B[0m";
+	};
 
-		puzzle_input.open(filename.str());
-		if (puzzle_input.is_open()) {
-			// Solve the puzzle!
-			result = f->second(AoC_part, puzzle_input);
-		}
+	// Input file and day solution invocation.
+	auto f = day_solvers.find(AoC_day);
+	if (f != day_solvers.end()) {
+		auto filename = input_option.empty() ? input_filename(AoC_day) : input_option;
+		bool from_stdin = ("-" == filename);
 
-		if (use_colors) std::cout << "\x1B[1;33m";
-		std::cout << "Result: ";
-		if (use_colors) std::cout << "\x1B[0;33m";
-		std::cout << result;
+		if (use_colors) std::cout << "\x1B[34m";
+		std::cout << "Puzzle input: " << (from_stdin ? "standard input" : filename) << std::endl;
 		if (use_colors) std::cout << "\x1B[0m";
-		std::cout << std::endl;
+
+		// Print the result of one part.
+		// Debug output of the day is written first.
+		auto print_result = [&](int part, long result, const std::string& timing) {
+			log_flush();
+			if (use_colors) std::cout << "\x1B[1;33m";
+			std::cout << "Result" << ((0 == AoC_part) ? (" part " + std::to_string(part)) : "") << ": ";
+			if (use_colors) std::cout << "\x1B[0;33m";
+			std::cout << result;
+			if (use_colors) std::cout << "\x1B[0m";
+			std::cout << " (" << timing << ")" << std::endl;
+		};
+
+		// Streaming: an input given on the command line is read one line at a
+		// time by the days that can do that, without holding the whole input.
+		// Binary input is always mapped.
+		if (!input_option.empty() && (nullptr != f->second.stream) && (from_stdin || !is_binary_file(filename))) {
+			if (from_stdin && (0 == AoC_part)) {
+				std::cerr << "Standard input can be read only once, give the part to solve" << std::endl;
+				return 1;
+			}
+			for (int part = 1; part <= 2; ++part) {
+				if ((AoC_part > 0) && (AoC_part != part)) continue;
+
+				std::vector<char> buffer(1 << 20);
+				std::ifstream puzzle_input;
+				puzzle_input.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+				puzzle_input.open(from_stdin ? "/dev/stdin" : filename);
+				if (!puzzle_input.is_open()) {
+					std::cerr << "Cannot open " << filename << std::endl;
+					return 1;
+				}
+
+				// Solve the puzzle!
+				trace_span span((1 == part) ? "stream part 1" : "stream part 2");
+				profile_scope profile;
+				reset_live_peak();
+				auto m0 = allocation_snapshot();
+				auto t0 = std::chrono::steady_clock::now();
+				long result;
+				try {
+					result = f->second.stream(part, puzzle_input);
+				} catch (const char* e) {
+					std::cerr << filename << ": " << e << std::endl;
+					return 1;
+				} catch (const std::exception& e) {
+					std::cerr << filename << ": " << e.what() << std::endl;
+					return 1;
+				}
+				auto t1 = std::chrono::steady_clock::now();
+				print_result(part, result, "streamed " + duration(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+				if (memory) print_memory("part " + std::to_string(part), memory_usage(m0, -1));
+			}
+			if (memory) print_memory("peak RSS", std::to_string(peak_rss()) + " bytes");
+			return finished(0);
+		}
+
+		// Memory-mapped input, no copying.
+		mapped_input input(from_stdin ? "/dev/stdin" : filename);
+		if (!input.is_open()) {
+			std::cerr << "Cannot open " << filename << std::endl;
+			return 1;
+		}
+
+		// Answers found in the cache are not solved again.  Debug, traced and
+		// profiled runs always solve, as the point is the output of those.
+		answer_cache cache(AoC_day, input.view(), use_cache && !debug && !tracing && profile_option.empty());
+
+		// Parse once, then solve the requested part or both parts.
+		// Parsed input lives in its own arena, each solve in a reset one.
+		// Parsed state can come from the cache too.
+		arena_resource parse_arena(huge_pages), solve_arena(huge_pages);
+		std::string data;		// Parsed state from the cache, which the parsed input may refer to.
+		std::unique_ptr<parsed_input> parsed;
+		long parse_ns = -1;		// Not parsed, every answer was cached.
+		bool parsed_from_cache = false;
+		std::string parse_memory;
+		auto parse = [&]() {
+			trace_span span("parse");
+			profile_scope profile;
+			reset_live_peak();
+			auto m0 = allocation_snapshot();
+			auto t0 = std::chrono::steady_clock::now();
+			arena_scope scope(parse_arena);
+			if ((nullptr != f->second.load) && cache.find_parsed(data)) parsed = f->second.load(data);
+			parsed_from_cache = (nullptr != parsed);
+			if (!parsed) parsed = f->second.parse(input.view());
+			auto t1 = std::chrono::steady_clock::now();
+			parse_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+			parse_memory = memory_usage(m0, parse_arena.allocated());
+			if (!parsed_from_cache && (nullptr != f->second.save) && cache.enabled()) {
+				std::string saved;
+				f->second.save(*parsed, saved);
+				cache.store_parsed(saved);
+			}
+		};
+
+		for (int part = 1; part <= 2; ++part) {
+			if ((AoC_part > 0) && (AoC_part != part)) continue;
+
+			long result;
+			if (cache.find_answer(part, result)) {
+				print_result(part, result, "cached");
+				continue;
+			}
+			if (!parsed) {
+				try {
+					parse();
+				} catch (const char* e) {
+					std::cerr << filename << ": " << e << std::endl;
+					return 1;
+				} catch (const std::exception& e) {
+					std::cerr << filename << ": " << e.what() << std::endl;
+					return 1;
+				}
+			}
+
+			// Solve the puzzle!
+			solve_arena.reset();
+			arena_scope scope(solve_arena);
+			trace_span span((1 == part) ? "solve part 1" : "solve part 2");
+			profile_scope profile;
+			reset_live_peak();
+			auto m0 = allocation_snapshot();
+			auto t0 = std::chrono::steady_clock::now();
+			try {
+				result = f->second.solve(part, *parsed);
+			} catch (const char* e) {
+				std::cerr << filename << ": " << e << std::endl;
+				return 1;
+			} catch (const std::exception& e) {
+				std::cerr << filename << ": " << e.what() << std::endl;
+				return 1;
+			}
+			auto t1 = std::chrono::steady_clock::now();
+			print_result(part, result, "solve " + duration(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+			if (memory) print_memory("part " + std::to_string(part), memory_usage(m0, solve_arena.allocated()));
+			cache.store_answer(part, result);
+		}
+		log_flush();
+		if (parse_ns >= 0) std::cout << "Parse: " << duration(parse_ns) << (parsed_from_cache ? " (cached)" : "") << std::endl;
+		if (memory && (parse_ns >= 0)) print_memory("parse", parse_memory);
+		if (memory) print_memory("peak RSS", std::to_string(peak_rss()) + " bytes");
+		if (cache.enabled()) std::cout << "Cache: " << cache.statistics() << std::endl;
 	}
 
-	return 0;
+	return finished(0);
 }
@@ -0,0 +1,85 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <malloc.h>
+#include <sys/resource.h>
+
+#include "aocmemory.h"
+
+bool counting_allocations = false;
+
+static std::atomic<long> allocations { 0 };
+static std::atomic<long> allocated_bytes { 0 };
+static std::atomic<long> live_bytes { 0 };
+static std::atomic<long> peak_bytes { 0 };
+
+
+static void counted_allocation(void* p)
+{
+	long size = malloc_usable_size(p);
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	long live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+	long peak = peak_bytes.load(std::memory_order_relaxed);
+	while ((live > peak) && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+
+static void* allocate(size_t size, size_t alignment = 0)
+{
+	void* p = (alignment > alignof(std::max_align_t))
+		? aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+		: malloc(size ? size : 1);
+	if (nullptr == p) throw std::bad_alloc();
+	if (counting_allocations) counted_allocation(p);
+	return p;
+}
+
+
+static void deallocate(void* p) noexcept
+{
+	if (counting_allocations && p) live_bytes.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+	free(p);
+}
+
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* p) noexcept { deallocate(p); }
+void operator delete[](void* p) noexcept { deallocate(p); }
+void operator delete(void* p, size_t) noexcept { deallocate(p); }
+void operator delete[](void* p, size_t) noexcept { deallocate(p); }
+void operator delete(void* p, std::align_val_t) noexcept { deallocate(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { deallocate(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { deallocate(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { deallocate(p); }
+
+
+allocation_counters allocation_snapshot()
+{
+	return {
+		allocations.load(std::memory_order_relaxed), allocated_bytes.load(std::memory_order_relaxed),
+		live_bytes.load(std::memory_order_relaxed), peak_bytes.load(std::memory_order_relaxed)
+	};
+}
+
+
+void reset_live_peak()
+{
+	peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+
+long peak_rss()
+{
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) < 0) return 0;
+	return usage.ru_maxrss * 1024L;		// Kilobytes on Linux.
+}
@@ -0,0 +1,30 @@
+#ifndef _AOCMEMORY_H_
+#define _AOCMEMORY_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+// Allocation counting in the global operator new and delete of this
+// program.  Counting is off unless turned on, and then costs a few atomic
+// adds per allocation.  Memory the day solutions allocate from an arena
+// does not go through operator new, see arena_resource::peak() for that.
+extern bool counting_allocations;
+
+// Allocations through operator new while counting was on.  Live bytes are
+// the bytes allocated and not yet deleted, and the peak is the most live
+// bytes since reset_live_peak().  Sizes are the usable sizes of malloc.
+struct allocation_counters {
+	long allocations = 0;
+	long bytes = 0;
+	long live = 0;
+	long peak = 0;
+};
+
+allocation_counters allocation_snapshot();
+
+// Start a new live high-water mark from the bytes live now.
+void reset_live_peak();
+
+// Peak resident set size of the process in bytes, from getrusage().
+long peak_rss();
+
+#endif /* _AOCMEMORY_H_ */
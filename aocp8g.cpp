@@ -0,0 +1,68 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+// Visualisation plugin aocp8g.so, the only part linked with the Precessing
+// graphics library.  Loaded by visual_function() in aocvisual.cpp.
+
+// Precessing graphics library.
+#include "p8g.hpp"
+
+#include "aocvisual.h"
+
+
+// Precessing draw() callback takes no arguments, so the pipeline to
+// visualise is passed in this pointer.  Set only just before p8g::run().
+static const pipeline_view* visual_params = nullptr;
+
+
+// Callback methods for Precessing.
+void p8g::keyPressed() {}
+void p8g::keyReleased() {}
+void p8g::mouseMoved() {}
+void p8g::mousePressed() {}
+void p8g::mouseReleased() {}
+void p8g::mouseWheel(float delta) {}
+
+// Visualise the pipeline using Precessing.
+void p8g::draw() {
+	using namespace p8g;
+	const pipeline_view& params = *visual_params;
+	background(18, 0, 31);
+	strokeWeight(params.scale);
+
+	stroke(255, 0, 0);	// Red box around.
+	fill(18, 0, 31);
+	rect(0, 0, width, height);
+
+	for (int y = 0; y < params.height; ++y) {
+		for (int x = 0; x < params.width; ++x) {
+			// Choose drawing colour.
+			if ((*params.pipeline)(x, y)) {
+				if ((y == params.start_y) && (x == params.start_x)) {		// Pipeline start location
+					stroke(227, 121, 51);
+				} else if ((y == params.end_y) && (x == params.end_x)) {	// Pipeline end location
+					stroke(240, 33, 33);
+				} else if ((y == params.bottom_y) && (x == params.bottom_x)) {	// Most bottom location
+					stroke(26, 121, 241);
+				} else {	// Normal pipeline
+					stroke(78, 154, 36);
+				}
+			} else {
+				stroke(220, 220, 220);
+			}
+			// Draw subpixels.
+			for (int suby = y * 3; suby < y * 3 + 3; ++suby) {
+				for (int subx = x * 3; subx < x * 3 + 3; ++subx) {
+					if ((*params.bitmap)(subx, suby)) point(subx * params.scale + 1, suby * params.scale + 1);
+				}
+			}
+		}
+	}
+}
+
+
+extern "C" void aoc_draw_pipeline(const pipeline_view& view)
+{
+	visual_params = &view;
+	p8g::run(view.width * 3 * view.scale + 2, view.height * 3 * view.scale + 2, "Day 10");
+	visual_params = nullptr;
+}
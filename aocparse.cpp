@@ -0,0 +1,121 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include <immintrin.h>
+
+#include "aocisa.h"
+#include "aocparse.h"
+
+
+// Scalar version, also used for the tail of the input in the vector versions.
+template <typename V>
+static void scan_scalar(std::string_view s, V& numbers)
+{
+	number_scanner scan(s);
+	for (typename V::value_type n = 0; scan.next(n); ) numbers.push_back(n);
+}
+
+
+// Convert 1-16 digits ending at p + len into a number.  The 16 bytes before
+// p + len must be readable.  Digits are subtracted, masked and then combined
+// pairwise: 2 digits into 16 bits, 4 digits into 32 bits and 8 digits into
+// 32 bits, and finally the two 8-digit halves.
+__attribute__((target("sse4.2")))
+static inline uint64_t digits16(const char* p, int len)
+{
+	const __m128i index = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + len - 16));
+	v = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+	v = _mm_and_si128(v, _mm_cmpgt_epi8(index, _mm_set1_epi8(15 - len)));	// Only the last len bytes.
+	v = _mm_maddubs_epi16(v, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+	v = _mm_madd_epi16(v, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+	v = _mm_packus_epi32(v, v);
+	v = _mm_madd_epi16(v, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+	uint64_t high = static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+	uint64_t low = static_cast<uint32_t>(_mm_extract_epi32(v, 1));
+	return high * 100000000 + low;
+}
+
+
+// Vector versions: classify a block of 16, 32 or 64 bytes at a time into
+// digits and others, then find the number starts and lengths from the bit
+// mask.  Numbers that cross the block, are too close to the start of the
+// input for digits16(), or have more digits than the type surely holds, are
+// parsed with std::from_chars instead.  Inlined into the variant of each level, so that the digit mask
+// and digits16() are compiled for that level too.
+template <size_t block, uint64_t (*digit_mask)(const char*), typename V>
+__attribute__((always_inline))
+static inline void scan_blocks(std::string_view s, V& numbers)
+{
+	typedef typename V::value_type T;
+	const char* base = s.data();
+	const size_t size = s.size();
+	constexpr int max_digits = std::min(16, std::numeric_limits<T>::digits10);
+
+	size_t pos = 0;
+	while (pos + block <= size) {
+		uint64_t digits = digit_mask(base + pos);
+		// Blocks start outside numbers, so a digit without a digit before it starts a number.
+		uint64_t starts = digits & ~(digits << 1);
+		size_t next = pos + block;
+		while (starts) {
+			int bit = __builtin_ctzll(starts);
+			int len = __builtin_ctzll(~(digits >> bit));	// Shifted in zeros stop this at the block end.
+			size_t start = pos + bit;
+			bool negative = (start > 0) && ('-' == base[start - 1]);
+			if ((bit + len == block) || (len > max_digits) || (start + len < 16)) {
+				// Crosses the block or does not fit digits16(), continue after it.
+				T n = 0;
+				auto r = std::from_chars(base + start - (negative ? 1 : 0), base + size, n);
+				check_number(r.ec);
+				numbers.push_back(n);
+				next = r.ptr - base;
+				break;
+			}
+			auto n = static_cast<T>(digits16(base + start, len));
+			numbers.push_back(negative ? -n : n);
+			starts &= starts - 1;
+		}
+		pos = next;
+	}
+	if ((pos > 0) && (pos < size) && ('-' == base[pos - 1])) --pos;	// Keep the sign of a number split by the last block.
+	scan_scalar(s.substr(pos), numbers);
+}
+
+template <typename V>
+__attribute__((target("sse4.2")))
+static void scan_sse42(std::string_view s, V& numbers) { scan_blocks<16, digit_mask16>(s, numbers); }
+
+template <typename V>
+__attribute__((target("avx2")))
+static void scan_avx2(std::string_view s, V& numbers) { scan_blocks<32, digit_mask32>(s, numbers); }
+
+template <typename V>
+__attribute__((target("avx512f,avx512bw")))
+static void scan_avx512(std::string_view s, V& numbers) { scan_blocks<64, digit_mask64>(s, numbers); }
+
+
+template <typename T, typename Allocator>
+void parse_numbers(std::string_view s, std::vector<T, Allocator>& numbers)
+{
+	typedef std::vector<T, Allocator> V;
+	static const isa_dispatch<void(std::string_view, V&)> scan { scan_scalar<V>, scan_sse42<V>, scan_avx2<V>, scan_avx512<V> };
+	scan.get()(s, numbers);
+}
+
+template void parse_numbers(std::string_view, std::vector<int>&);
+template void parse_numbers(std::string_view, std::vector<long>&);
+template void parse_numbers(std::string_view, std::pmr::vector<int>&);
+template void parse_numbers(std::string_view, std::pmr::vector<long>&);
+
+
+void parse_numbers_scalar(std::string_view s, std::vector<long>& numbers)
+{
+	scan_scalar(s, numbers);
+}
@@ -0,0 +1,70 @@
+#ifndef _AOCPARSE_H_
+#define _AOCPARSE_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <cctype>
+#include <charconv>
+#include <system_error>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+// Integer parsing without std::string copies or streams.
+
+// Integers too large for their type are errors in the puzzle input.
+inline void check_number(std::errc ec)
+{
+	if (std::errc::result_out_of_range == ec) throw "Number out of range";
+}
+
+// Return the integer at the start of s, after any spaces.  Zero if there is none.
+template <typename T = long>
+inline T to_number(std::string_view s)
+{
+	size_t i = s.find_first_not_of(' ');
+	T n = 0;
+	if (std::string_view::npos != i) check_number(std::from_chars(s.data() + i, s.data() + s.size(), n).ec);
+	return n;
+}
+
+
+// Reads the integers of a string one at a time, skipping whatever is
+// between them.  A minus sign right before the digits is part of the number.
+//
+//	number_scanner scan(line);
+//	for (long n; scan.next(n); ) { ... }
+class number_scanner {
+public:
+	explicit number_scanner(std::string_view s) : p(s.data()), end(s.data() + s.size()) {}
+
+	template <typename T>
+	bool next(T& n) {
+		while ((p < end) && !isdigit(*p) && !(('-' == *p) && (p + 1 < end) && isdigit(p[1]))) ++p;
+		if (p >= end) return false;
+		auto r = std::from_chars(p, end, n);
+		check_number(r.ec);
+		p = r.ptr;
+		return true;
+	}
+
+	// Rest of the string, after the last number read.
+	std::string_view rest() const { return { p, static_cast<size_t>(end - p) }; }
+
+private:
+	const char* p;
+	const char* end;
+};
+
+
+// Append all integers of a whitespace separated list to 'numbers'.
+// Throws when a number does not fit in T.
+// Finds and converts the numbers with the vector kernel of current_isa().
+// Defined for int and long, with the standard and the pmr allocators.
+template <typename T, typename Allocator>
+void parse_numbers(std::string_view s, std::vector<T, Allocator>& numbers);
+
+// Same using only number_scanner, for comparison.
+void parse_numbers_scalar(std::string_view s, std::vector<long>& numbers);
+
+#endif /* _AOCPARSE_H_ */
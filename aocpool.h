@@ -0,0 +1,83 @@
+#ifndef _AOCPOOL_H_
+#define _AOCPOOL_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Bounded pool of worker threads executing queued jobs.
+// The number of threads defaults to the number of cores.
+class worker_pool {
+public:
+	explicit worker_pool(unsigned threads = std::thread::hardware_concurrency()) {
+		if (threads < 1) threads = 1;
+		for (unsigned i = 0; i < threads; ++i) {
+			workers.emplace_back([this] { work(); });
+		}
+	}
+
+	// Finishes all queued jobs before returning.
+	~worker_pool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		job_available.notify_all();
+		for (auto& w : workers) w.join();
+	}
+
+	worker_pool(const worker_pool&) = delete;
+	worker_pool& operator=(const worker_pool&) = delete;
+
+	// Queue a job for execution.
+	void submit(std::function<void()> job) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			jobs.push_back(std::move(job));
+			++unfinished;
+		}
+		job_available.notify_one();
+	}
+
+	// Block until every submitted job has finished.
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		all_done.wait(lock, [this] { return 0 == unfinished; });
+	}
+
+	size_t size() const { return workers.size(); }
+
+private:
+	void work() {
+		for (;;) {
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				job_available.wait(lock, [this] { return stopping || !jobs.empty(); });
+				if (jobs.empty()) return;	// Stopping and nothing left to do.
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+			job();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (0 == --unfinished) all_done.notify_all();
+			}
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> jobs;
+	std::mutex mutex;
+	std::condition_variable job_available;
+	std::condition_variable all_done;
+	size_t unfinished = 0;
+	bool stopping = false;
+};
+
+#endif /* _AOCPOOL_H_ */
@@ -0,0 +1,158 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include "aocprofile.h"
+
+
+// Samples are written by the signal handler into a buffer reserved up
+// front, as the handler must not allocate.  Samples after the buffer is
+// full are only counted.
+constexpr int max_depth = 64;
+constexpr long max_samples = 1 << 16;
+
+struct profile_sample {
+	int depth;
+	void* frames[max_depth];
+};
+
+static std::vector<profile_sample> samples;
+static std::atomic<long> sample_count { 0 };
+static long interval = 0;		// Timer interval in microseconds, zero when not started.
+
+
+static void on_sigprof(int, siginfo_t*, void*)
+{
+	int saved_errno = errno;
+	long i = sample_count.fetch_add(1, std::memory_order_relaxed);
+	if (i < max_samples) samples[i].depth = backtrace(samples[i].frames, max_depth);
+	errno = saved_errno;
+}
+
+
+bool start_profile(long interval_us)
+{
+	samples.resize(max_samples);
+
+	// The first backtrace() loads the unwinder, which is not safe in a signal handler.
+	void* frames[max_depth];
+	backtrace(frames, max_depth);
+
+	struct sigaction action {};
+	action.sa_sigaction = on_sigprof;
+	action.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	if (sigaction(SIGPROF, &action, nullptr) < 0) return false;
+	interval = interval_us;
+	return true;
+}
+
+
+profile_scope::profile_scope()
+{
+	if (0 == interval) return;
+	struct itimerval timer {};
+	timer.it_interval.tv_usec = interval % 1000000;
+	timer.it_interval.tv_sec = interval / 1000000;
+	timer.it_value = timer.it_interval;
+	setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+
+profile_scope::~profile_scope()
+{
+	if (0 == interval) return;
+	struct itimerval timer {};
+	setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+
+// Function name without the parameter list, or the object file and offset
+// when the address has no dynamic symbol.  Semicolons separate the frames
+// of a folded stack, so none are left in the name.
+static std::string function_name(void* address)
+{
+	Dl_info info {};
+	if ((0 == dladdr(address, &info)) || (nullptr == info.dli_fname)) return "[unknown]";
+	if (nullptr == info.dli_sname) {
+		std::string object = info.dli_fname;
+		char offset[32];
+		snprintf(offset, sizeof(offset), "+0x%lx", static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+		return "[" + object.substr(object.rfind('/') + 1) + offset + "]";
+	}
+
+	int status = 0;
+	char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+	std::string name = (0 == status) ? demangled : info.dli_sname;
+	free(demangled);
+
+	// Cut at the parameter list, the first parenthesis outside template
+	// arguments and lambda names, other than that of operator().
+	int depth = 0;
+	for (size_t i = 0; i < name.size(); ++i) {
+		char c = name[i];
+		if (0 == name.compare(i, 10, "operator()")) i += 9;
+		else if (('<' == c) || ('{' == c)) ++depth;
+		else if (('>' == c) || ('}' == c)) --depth;
+		else if (('(' == c) && (0 == depth)) {
+			name.resize(i);
+			break;
+		}
+	}
+	for (auto& c : name) if (';' == c) c = ',';
+	return name;
+}
+
+
+bool write_profile(const std::string& filename, long& written)
+{
+	// Resolve each address once.  Return addresses point after the call, so
+	// the frames above the interrupted one are looked up one byte earlier.
+	std::map<void*, std::string> names;
+	auto name_of = [&](void* address) -> const std::string& {
+		auto n = names.find(address);
+		if (n == names.end()) n = names.emplace(address, function_name(address)).first;
+		return n->second;
+	};
+
+	// Leaf first stacks into root first folded stacks.  The first two frames
+	// are the signal handler and the signal return trampoline, and the
+	// frames above main() are the C library start up.
+	std::map<std::string, long> stacks;
+	long count = std::min(sample_count.load(), max_samples);
+	for (long i = 0; i < count; ++i) {
+		const auto& sample = samples[i];
+		std::string stack;
+		for (int f = sample.depth - 1; f >= 2; --f) {
+			void* address = static_cast<char*>(sample.frames[f]) - ((f > 2) ? 1 : 0);
+			const auto& name = name_of(address);
+			if ("main" == name) stack.clear();
+			if (!stack.empty()) stack += ';';
+			stack += name;
+		}
+		if (!stack.empty()) ++stacks[stack];
+	}
+
+	std::ofstream out(filename);
+	written = 0;
+	for (const auto& [stack, n] : stacks) {
+		out << stack << ' ' << n << '\n';
+		written += n;
+	}
+	return static_cast<bool>(out);
+}
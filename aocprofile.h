@@ -0,0 +1,38 @@
+#ifndef _AOCPROFILE_H_
+#define _AOCPROFILE_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <string>
+
+// Sampling profiler without perf: a SIGPROF interval timer interrupts the
+// program every 'interval_us' microseconds of CPU time while a
+// profile_scope is alive, and the signal handler records the stack with
+// backtrace().  The stacks are resolved into function names only when the
+// profile is written, as folded stacks for flamegraph tools:
+//
+//	main;pipeloop;paint 123
+//
+// Functions are named from the dynamic symbol table, so the program is
+// linked with -rdynamic.  Static and inlined functions count towards the
+// function they are in.
+
+// Install the signal handler and reserve the sample buffer.  Returns false
+// if the handler cannot be installed.  Sampling starts in a profile_scope.
+bool start_profile(long interval_us = 1000);
+
+// Samples while alive, when start_profile() was called.
+class profile_scope {
+public:
+	profile_scope();
+	~profile_scope();
+
+	profile_scope(const profile_scope&) = delete;
+	profile_scope& operator=(const profile_scope&) = delete;
+};
+
+// Write the samples as folded stacks.  Returns false if the file cannot be
+// written.  'samples' is set to the number of samples written.
+bool write_profile(const std::string& filename, long& samples);
+
+#endif /* _AOCPROFILE_H_ */
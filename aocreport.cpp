@@ -0,0 +1,220 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "aocreport.h"
+
+// Git revision is written into this file by the Makefile.
+#if __has_include("aocrevision.inc")
+#include "aocrevision.inc"
+#endif
+#ifndef AOC_REVISION
+#define AOC_REVISION "unknown"
+#endif
+
+
+const char* build_revision()
+{
+	return AOC_REVISION;
+}
+
+
+// Quote a string for JSON.  Revisions, hashes and such do not need
+// more escaping than this.
+static std::string quoted(const std::string& s)
+{
+	std::string q = "\"";
+	for (auto c : s) {
+		if (('"' == c) || ('\\' == c)) q += '\\';
+		q += c;
+	}
+	return q + "\"";
+}
+
+
+bool write_json(const std::string& filename, const std::vector<bench_record>& records)
+{
+	std::ofstream out(filename);
+	if (!out.is_open()) return false;
+	out << "[\n";
+	for (size_t i = 0; i < records.size(); ++i) {
+		const auto& r = records[i];
+		out << "  {\"revision\": " << quoted(r.revision)
+			<< ", \"day\": " << r.day << ", \"part\": " << r.part << ", \"iteration\": " << r.iteration
+			<< ", \"input_hash\": " << quoted(r.input_hash) << ", \"input_bytes\": " << r.input_bytes
+			<< ", \"parse_ns\": " << r.parse_ns << ", \"solve_ns\": " << r.solve_ns << ", \"total_ns\": " << r.total_ns
+			<< ", \"result\": " << r.result << "}" << ((i + 1 < records.size()) ? "," : "") << "\n";
+	}
+	out << "]\n";
+	return out.good();
+}
+
+
+bool write_csv(const std::string& filename, const std::vector<bench_record>& records)
+{
+	std::ofstream out(filename);
+	if (!out.is_open()) return false;
+	out << "revision,day,part,iteration,input_hash,input_bytes,parse_ns,solve_ns,total_ns,result\n";
+	for (const auto& r : records) {
+		out << r.revision << "," << r.day << "," << r.part << "," << r.iteration << ","
+			<< r.input_hash << "," << r.input_bytes << ","
+			<< r.parse_ns << "," << r.solve_ns << "," << r.total_ns << "," << r.result << "\n";
+	}
+	return out.good();
+}
+
+
+// Minimal reader for the JSON written above: an array of flat objects
+// with string and integer values.
+class json_reader {
+public:
+	json_reader(const std::string& text) : text(text) {}
+
+	std::vector<bench_record> records() {
+		std::vector<bench_record> v;
+		expect('[');
+		if (peek() == ']') { ++pos; return v; }
+		for (;;) {
+			v.push_back(record());
+			char c = next();
+			if (']' == c) break;
+			if (',' != c) throw "Expected , or ] in array";
+		}
+		return v;
+	}
+
+private:
+	bench_record record() {
+		bench_record r;
+		expect('{');
+		if (peek() == '}') { ++pos; return r; }
+		for (;;) {
+			auto key = string();
+			expect(':');
+			if (peek() == '"') {
+				auto value = string();
+				if ("revision" == key) r.revision = value;
+				else if ("input_hash" == key) r.input_hash = value;
+			} else {
+				long value = number();
+				if ("day" == key) r.day = value;
+				else if ("part" == key) r.part = value;
+				else if ("iteration" == key) r.iteration = value;
+				else if ("input_bytes" == key) r.input_bytes = value;
+				else if ("parse_ns" == key) r.parse_ns = value;
+				else if ("solve_ns" == key) r.solve_ns = value;
+				else if ("total_ns" == key) r.total_ns = value;
+				else if ("result" == key) r.result = value;
+			}
+			char c = next();
+			if ('}' == c) break;
+			if (',' != c) throw "Expected , or } in object";
+		}
+		return r;
+	}
+
+	std::string string() {
+		expect('"');
+		std::string s;
+		while ((pos < text.length()) && ('"' != text[pos])) {
+			if (('\\' == text[pos]) && (pos + 1 < text.length())) ++pos;
+			s += text[pos++];
+		}
+		expect('"');
+		return s;
+	}
+
+	long number() {
+		skip();
+		size_t used = 0;
+		long n = std::stol(text.substr(pos, 32), &used);
+		pos += used;
+		return n;
+	}
+
+	void skip() { while ((pos < text.length()) && isspace(text[pos])) ++pos; }
+	char peek() { skip(); return (pos < text.length()) ? text[pos] : 0; }
+	char next() { char c = peek(); ++pos; return c; }
+	void expect(char c) { if (next() != c) throw "Unexpected character in JSON"; }
+
+	const std::string& text;
+	size_t pos = 0;
+};
+
+
+bool read_json(const std::string& filename, std::vector<bench_record>& records, std::string& error)
+{
+	std::ifstream in(filename);
+	if (!in.is_open()) {
+		error = "cannot open " + filename;
+		return false;
+	}
+	std::stringstream text;
+	text << in.rdbuf();
+	try {
+		records = json_reader(text.str()).records();
+	} catch (const char* e) {
+		error = filename + ": " + e;
+		return false;
+	} catch (const std::exception& e) {
+		error = filename + ": " + e.what();
+		return false;
+	}
+	return true;
+}
+
+
+// Median of the samples, reordering them.
+static double median(std::vector<long>& v)
+{
+	size_t half = v.size() / 2;
+	std::nth_element(v.begin(), v.begin() + half, v.end());
+	double m = v[half];
+	if (0 == (v.size() % 2)) {
+		m = (m + *std::max_element(v.begin(), v.begin() + half)) / 2;
+	}
+	return m;
+}
+
+
+comparison compare(const std::vector<long>& baseline, const std::vector<long>& current, double threshold, double confidence, int resamples)
+{
+	comparison c;
+	if (baseline.empty() || current.empty()) return c;
+
+	std::vector<long> b = baseline, a = current;
+	double bm = median(b), am = median(a);
+	c.baseline_median = std::lround(bm);
+	c.current_median = std::lround(am);
+	c.ratio = (bm > 0) ? am / bm : 1.0;
+
+	// Resample both sets with replacement and collect the ratios of medians.
+	// Fixed seed, so the same data always gives the same verdict.
+	std::mt19937_64 rng(2023);
+	std::vector<double> ratios;
+	ratios.reserve(resamples);
+	std::vector<long> rb(b.size()), ra(a.size());
+	std::uniform_int_distribution<size_t> pick_b(0, b.size() - 1), pick_a(0, a.size() - 1);
+	for (int i = 0; i < resamples; ++i) {
+		for (auto& x : rb) x = b[pick_b(rng)];
+		for (auto& x : ra) x = a[pick_a(rng)];
+		double m = median(rb);
+		ratios.push_back((m > 0) ? median(ra) / m : 1.0);
+	}
+	std::sort(ratios.begin(), ratios.end());
+
+	// Percentile interval.
+	double tail = (1.0 - confidence) / 2;
+	c.low = ratios[static_cast<size_t>(tail * (resamples - 1))];
+	c.high = ratios[static_cast<size_t>((1.0 - tail) * (resamples - 1))];
+	c.slower = c.low > 1.0 + threshold;
+	c.faster = c.high < 1.0 - threshold;
+	return c;
+}
@@ -0,0 +1,52 @@
+#ifndef _AOCREPORT_H_
+#define _AOCREPORT_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <string>
+#include <vector>
+
+// One timed benchmark iteration.
+struct bench_record {
+	std::string revision;		// Git revision of the build.
+	int day = 0;
+	int part = 0;
+	int iteration = 0;
+	std::string input_hash;		// Hash of the puzzle input contents.
+	long input_bytes = 0;
+	long parse_ns = 0;
+	long solve_ns = 0;
+	long total_ns = 0;
+	long result = 0;
+};
+
+// Git revision this program was built from.
+const char* build_revision();
+
+// Write the records as a JSON array of objects, or as CSV with a header line.
+// Return false if the file cannot be written.
+bool write_json(const std::string& filename, const std::vector<bench_record>& records);
+bool write_csv(const std::string& filename, const std::vector<bench_record>& records);
+
+// Read records written by write_json().
+// Return false, with the reason in 'error', if the file cannot be read.
+bool read_json(const std::string& filename, std::vector<bench_record>& records, std::string& error);
+
+// Bootstrap comparison of two sets of timings: ratio of the current median
+// to the baseline median, with a confidence interval for the ratio.
+// A change is significant when the whole interval is beyond the threshold,
+// eg. 0.05 ignores changes that could be less than 5 %.
+struct comparison {
+	long baseline_median = 0;
+	long current_median = 0;
+	double ratio = 1.0;
+	double low = 1.0;			// Confidence interval of the ratio.
+	double high = 1.0;
+	bool slower = false;		// Whole interval above 1 + threshold: a significant slowdown.
+	bool faster = false;		// Whole interval below 1 - threshold: a significant speedup.
+};
+
+comparison compare(const std::vector<long>& baseline, const std::vector<long>& current,
+	double threshold = 0.0, double confidence = 0.95, int resamples = 2000);
+
+#endif /* _AOCREPORT_H_ */
@@ -0,0 +1,151 @@
+#ifndef _AOCSERIAL_H_
+#define _AOCSERIAL_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Writes parsed state as a flat sequence of 64-bit words in host byte
+// order.  Lists are written as their length followed by the items, and
+// lists of 32-bit items are packed two in a word.
+//
+//	serial_writer w(out);
+//	w.put_all(seeds);
+class serial_writer {
+public:
+	explicit serial_writer(std::string& out) : out(out) {}
+
+	void put(int64_t v) { out.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+	template <typename R>
+	void put_all(const R& values) {
+		put(std::size(values));
+		for (auto v : values) put(v);
+	}
+
+	template <typename R>
+	void put_all32(const R& values) {
+		put(std::size(values));
+		for (uint32_t v : values) out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+		if (std::size(values) % 2) out.append(sizeof(uint32_t), '\0');
+	}
+
+private:
+	std::string& out;
+};
+
+// Reads what serial_writer wrote.  Reading past the end fails, and the
+// reader stays failed, so a whole structure can be read before checking.
+class serial_reader {
+public:
+	explicit serial_reader(std::string_view in) : in(in) {}
+
+	bool get(int64_t& v) {
+		if (in.size() < sizeof(v)) {
+			failed = true;
+			return false;
+		}
+		memcpy(&v, in.data(), sizeof(v));
+		in.remove_prefix(sizeof(v));
+		return true;
+	}
+
+	// Length of a list, failing if the rest of the input is too short for
+	// that many items of the given number of words.
+	bool get_length(int64_t& n, size_t words = 1) {
+		if (get(n) && (n >= 0) && (static_cast<uint64_t>(n) <= in.size() / (words * sizeof(int64_t)))) return true;
+		failed = true;
+		return false;
+	}
+
+	template <typename V>
+	bool get_all(V& values) {
+		int64_t n = 0;
+		if (!get_length(n)) return false;
+		values.reserve(n);
+		for (int64_t v; (n-- > 0) && get(v); ) values.push_back(v);
+		return !failed;
+	}
+
+	// A list used in place, without copying.  The input must be aligned
+	// for the items, as a mapped binary input is.
+	template <typename T>
+	bool get_span(std::span<const T>& values) {
+		int64_t n = 0;
+		if (!get(n)) return false;
+		if ((n < 0) || (static_cast<uint64_t>(n) > in.size() / sizeof(T)) || (0 != reinterpret_cast<uintptr_t>(in.data()) % alignof(T))) {
+			failed = true;
+			return false;
+		}
+		// Padded to whole words.
+		size_t bytes = std::min(in.size(), (n * sizeof(T) + sizeof(int64_t) - 1) / sizeof(int64_t) * sizeof(int64_t));
+		values = { reinterpret_cast<const T*>(in.data()), static_cast<size_t>(n) };
+		in.remove_prefix(bytes);
+		return true;
+	}
+
+	bool ok() const { return !failed; }
+	bool at_end() const { return !failed && in.empty(); }
+
+private:
+	std::string_view in;
+	bool failed = false;
+};
+
+
+// Binary pre-parsed input: this header and the parsed state of the day,
+// written with serial_writer.  The header keeps the parsed state 8-byte
+// aligned, so that a mapped file can be used in place.  The version changes
+// whenever the layout of any day changes.
+struct binary_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t day;
+};
+
+constexpr char binary_magic[8] = { 'A', 'o', 'C', '2', '0', '2', '3', 'B' };
+constexpr uint32_t binary_version = 2;
+
+inline void write_binary_header(std::string& out, int day)
+{
+	binary_header header { {}, binary_version, static_cast<uint32_t>(day) };
+	memcpy(header.magic, binary_magic, sizeof(header.magic));
+	out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+// If the input is in the binary format, set 'payload' to the parsed state in
+// it and return true.  Binary input of another day or version is an error.
+inline bool binary_payload(std::string_view input, int day, std::string_view& payload)
+{
+	binary_header header;
+	if ((input.size() < sizeof(header)) || (0 != memcmp(input.data(), binary_magic, sizeof(binary_magic)))) return false;
+	memcpy(&header, input.data(), sizeof(header));
+	if ((binary_version != header.version) || (static_cast<uint32_t>(day) != header.day)) throw "Binary input of another day or format version";
+	payload = input.substr(sizeof(header));
+	return true;
+}
+
+// Parsed state loaded from binary input, which must be valid.
+template <typename T>
+T valid_binary(T parsed)
+{
+	if (!parsed) throw "Invalid binary input";
+	return parsed;
+}
+
+// True if the file starts like a binary input.
+inline bool is_binary_file(const std::string& filename)
+{
+	char magic[sizeof(binary_magic)] {};
+	std::ifstream file(filename, std::ios::binary);
+	return file.read(magic, sizeof(magic)) && (0 == memcmp(magic, binary_magic, sizeof(magic)));
+}
+
+#endif /* _AOCSERIAL_H_ */
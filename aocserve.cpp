@@ -0,0 +1,345 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "aoc.h"
+#include "aocarena.h"
+#include "aocbench.h"
+#include "aocinput.h"
+#include "aocpool.h"
+#include "aocserve.h"
+
+
+// Largest puzzle input accepted in a request.
+constexpr size_t max_request = size_t(1) << 30;
+
+
+// Parsed state of one puzzle input, kept for later requests of the same input.
+struct warm_state {
+	int day;
+	uint64_t hash;
+	std::string input;		// Parsed state may refer to the input, so it is kept as well.
+	arena_resource arena;	// Parsed state lives here, declared first to outlive it.
+	std::unique_ptr<parsed_input> parsed;
+};
+
+// Most recently used parsed states.  Entries are shared, so one evicted while
+// a request is still solving from it stays alive until the request is done.
+class warm_cache {
+public:
+	explicit warm_cache(size_t capacity) : capacity(capacity) {}
+
+	std::shared_ptr<const warm_state> find(int day, uint64_t hash, std::string_view input) {
+		std::lock_guard<std::mutex> lock(mutex);
+		return find_locked(day, hash, input);
+	}
+
+	// Insert a parsed state and return the one to solve from.  Another
+	// request may have parsed the same input meanwhile: then its entry is
+	// kept and returned, so the cache holds each input only once.
+	std::shared_ptr<const warm_state> insert(std::shared_ptr<const warm_state> state) {
+		if (0 == capacity) return state;
+		std::lock_guard<std::mutex> lock(mutex);
+		if (auto warm = find_locked(state->day, state->hash, state->input)) return warm;
+		entries.push_front(std::move(state));
+		if (entries.size() > capacity) entries.pop_back();
+		return entries.front();
+	}
+
+private:
+	std::shared_ptr<const warm_state> find_locked(int day, uint64_t hash, std::string_view input) {
+		for (auto it = entries.begin(); it != entries.end(); ++it) {
+			// The hash only picks the candidate, the input decides.
+			if (((*it)->day != day) || ((*it)->hash != hash) || ((*it)->input != input)) continue;
+			entries.splice(entries.begin(), entries, it);
+			return entries.front();
+		}
+		return nullptr;
+	}
+
+	std::mutex mutex;
+	std::list<std::shared_ptr<const warm_state>> entries;	// Most recently used first.
+	const size_t capacity;
+};
+
+
+// Set by SIGINT and SIGTERM to stop accepting connections.
+static volatile sig_atomic_t stopping = 0;
+
+static void stop(int)
+{
+	stopping = 1;
+}
+
+// Block SIGINT and SIGTERM in the calling thread, so that they interrupt
+// accept() in the main thread and not a read or a solve.
+static void block_stop_signals(int how = SIG_BLOCK)
+{
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	pthread_sigmask(how, &signals, nullptr);
+}
+
+
+// Open connections, each read by a thread of its own, so that an idle or
+// slow client holds only its own thread and never a solve worker.  The
+// number of them is limited separately from the workers.  A connection is
+// closed under the lock when its thread is done, so its descriptor is not
+// reused by a new connection before the thread is joined.
+class connection_set {
+public:
+	explicit connection_set(size_t limit) : limit(limit) {}
+
+	// Read the connection with 'reader' on a thread of its own.  Returns
+	// false, leaving the connection open, when the limit is reached.
+	template <typename F>
+	bool start(int fd, F reader) {
+		std::lock_guard<std::mutex> lock(mutex);
+		reap();
+		if (threads.size() >= limit) return false;
+		threads.emplace(fd, std::thread([this, fd, reader] {
+			block_stop_signals();
+			reader(fd);
+			std::lock_guard<std::mutex> lock(mutex);
+			::close(fd);
+			finished.push_back(fd);
+		}));
+		return true;
+	}
+
+	// Cut off the open connections and wait for their threads to end.
+	void stop() {
+		std::map<int, std::thread> stopped;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			reap();
+			for (const auto& t : threads) {
+				if (std::find(finished.begin(), finished.end(), t.first) == finished.end()) ::shutdown(t.first, SHUT_RDWR);
+			}
+			std::swap(stopped, threads);
+		}
+		for (auto& t : stopped) t.second.join();
+	}
+
+private:
+	// Join the threads that are done.  Called with the lock held.
+	void reap() {
+		for (auto fd : finished) {
+			threads[fd].join();
+			threads.erase(fd);
+		}
+		finished.clear();
+	}
+
+	std::mutex mutex;
+	std::map<int, std::thread> threads;	// By connection descriptor.
+	std::vector<int> finished;			// Connections closed, threads to join.
+	const size_t limit;
+};
+
+
+// Read exactly n bytes.  Returns false at end of file or on error.
+static bool read_all(int fd, char* p, size_t n)
+{
+	while (n > 0) {
+		ssize_t r = ::read(fd, p, n);
+		if ((r < 0) && (EINTR == errno)) continue;
+		if (r <= 0) return false;
+		p += r;
+		n -= r;
+	}
+	return true;
+}
+
+// Read a line without the line feed.  Returns false at end of file or on error.
+static bool read_line(int fd, std::string& line)
+{
+	line.clear();
+	for (char c; read_all(fd, &c, 1); ) {
+		if ('\n' == c) return true;
+		if (line.size() > 100) return false;	// Not a request header.
+		line += c;
+	}
+	return false;
+}
+
+static bool write_all(int fd, std::string_view s)
+{
+	while (!s.empty()) {
+		ssize_t w = ::send(fd, s.data(), s.size(), MSG_NOSIGNAL);
+		if ((w < 0) && (EINTR == errno)) continue;
+		if (w <= 0) return false;
+		s.remove_prefix(w);
+	}
+	return true;
+}
+
+
+// Solve a request, parsing the input unless its parsed state is warm.
+// Returns the response line.
+static std::string solve_request(int day, int part, std::string input, warm_cache& cache)
+{
+	using clock = std::chrono::steady_clock;
+	auto f = day_solvers.find(day);
+	if (f == day_solvers.end()) return "error no solution for day " + std::to_string(day) + "\n";
+	const auto& solver = f->second;
+
+	auto t0 = clock::now();
+	uint64_t hash = input_hash(input);
+	auto state = cache.find(day, hash, input);
+	bool warm = (nullptr != state);
+	std::string response;
+	try {
+		if (!warm) {
+			auto cold = std::make_shared<warm_state>();
+			cold->day = day;
+			cold->hash = hash;
+			cold->input = std::move(input);
+			arena_scope scope(cold->arena);
+			cold->parsed = solver.parse(cold->input);
+			state = cache.insert(std::move(cold));
+		}
+		// Each worker reuses its solve arena from one request to the next.
+		thread_local arena_resource arena;
+		long result;
+		{
+			arena_scope scope(arena);
+			result = solver.solve(part, *state->parsed);
+		}
+		arena.reset();
+		response = "ok " + std::to_string(result) + "\n";
+	} catch (const char* e) {
+		response = std::string("error ") + e + "\n";
+	} catch (const std::exception& e) {
+		response = std::string("error ") + e.what() + "\n";
+	} catch (...) {
+		response = "error unknown failure\n";
+	}
+	long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count();
+
+	std::stringstream log;
+	log << "Day " << day << " part " << part << " input " << std::hex << hash << std::dec
+		<< (warm ? " warm" : " parsed") << " " << duration(ns) << ": " << response;
+	std::cout << log.str() << std::flush;
+	return response;
+}
+
+
+// Answer the requests of one connection until it is closed.
+// The connection waits here while the pool solves its request.
+static void connection(int fd, worker_pool& pool, warm_cache& cache)
+{
+	for (std::string header; read_line(fd, header); ) {
+		std::istringstream fields(header);
+		int day = 0, part = 0;
+		size_t length = 0;
+		if (!(fields >> day >> part >> length) || (part < 1) || (part > 2) || (length > max_request)) {
+			write_all(fd, "error bad request header\n");
+			break;
+		}
+		// The request is untrusted: a failure to hold it is an error reply,
+		// not the end of the server.
+		std::string input;
+		try {
+			input.resize(length);
+		} catch (const std::bad_alloc&) {
+			write_all(fd, "error request too large\n");
+			break;
+		}
+		if (!read_all(fd, input.data(), length)) break;
+
+		std::promise<std::string> response;
+		auto answered = response.get_future();
+		pool.submit([&, day, part, input = std::move(input)]() mutable {
+			response.set_value(solve_request(day, part, std::move(input), cache));
+		});
+		if (!write_all(fd, answered.get())) break;
+	}
+}
+
+
+int serve(const serve_options& options)
+{
+	sockaddr_un address {};
+	address.sun_family = AF_UNIX;
+	if (options.socket.size() >= sizeof(address.sun_path)) {
+		std::cerr << "Socket path too long: " << options.socket << std::endl;
+		return 1;
+	}
+	strcpy(address.sun_path, options.socket.c_str());
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0) {
+		std::cerr << "socket: " << strerror(errno) << std::endl;
+		return 1;
+	}
+	unlink(options.socket.c_str());		// Left over from an earlier server.
+	if ((bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) || (listen(listener, 64) < 0)) {
+		std::cerr << options.socket << ": " << strerror(errno) << std::endl;
+		::close(listener);
+		return 1;
+	}
+
+	// No SA_RESTART, so that accept() returns when interrupted.
+	struct sigaction action {};
+	action.sa_handler = stop;
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+
+	// Debug output from several threads would be just noise.
+	debug = false;
+
+	// The workers start with the stop signals blocked.
+	block_stop_signals();
+	worker_pool pool;
+	block_stop_signals(SIG_UNBLOCK);
+	warm_cache cache(options.warm_entries);
+	connection_set connections(options.max_connections);
+	std::cout << "Serving on " << options.socket << " with " << pool.size() << " workers" << std::endl;
+
+	while (!stopping) {
+		int fd = accept(listener, nullptr, nullptr);
+		if (fd < 0) {
+			if (EINTR == errno) continue;
+			std::cerr << "accept: " << strerror(errno) << std::endl;
+			break;
+		}
+		if (!connections.start(fd, [&pool, &cache](int fd) { connection(fd, pool, cache); })) {
+			write_all(fd, "error too many connections\n");
+			::close(fd);
+		}
+	}
+
+	// Connections still open are cut off, and requests being solved finish
+	// before the pool is done.
+	::close(listener);
+	connections.stop();
+	pool.wait();
+	unlink(options.socket.c_str());
+	std::cout << "Stopped" << std::endl;
+	return 0;
+}
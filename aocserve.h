@@ -0,0 +1,27 @@
+#ifndef _AOCSERVE_H_
+#define _AOCSERVE_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <cstddef>
+#include <string>
+
+// Server options.
+struct serve_options {
+	std::string socket;				// Path of the Unix domain socket.
+	size_t warm_entries = 16;		// Parsed inputs kept for later requests.
+	size_t max_connections = 64;	// Connections open at a time.
+};
+
+// Serve day solutions over a Unix domain socket until interrupted.
+// Each request is a header line "<day> <part> <length>" followed by length
+// bytes of puzzle input, and is answered with a line "ok <answer>" or
+// "error <message>".  A connection can send any number of requests.
+// Each connection is read by a thread of its own, up to a limit, and its
+// requests are solved on a worker pool sized to the core count.  The parsed
+// state of recent inputs is kept by day and input hash, so a repeated
+// input skips the parse step.  Each request is logged to standard output.
+// Returns the process exit code.
+int serve(const serve_options& options);
+
+#endif /* _AOCSERVE_H_ */
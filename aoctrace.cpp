@@ -0,0 +1,93 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "aoctrace.h"
+
+bool tracing = false;
+
+
+// Spans of one thread.  Buffers are owned by the registry, so they outlive
+// their threads and can be written after the worker threads are gone.
+struct trace_event {
+	const char* name;
+	long start_ns;
+	long duration_ns;
+};
+
+struct trace_buffer {
+	int thread;
+	std::vector<trace_event> events;
+};
+
+static std::mutex registry_mutex;
+static std::vector<std::unique_ptr<trace_buffer>> registry;
+static const auto trace_epoch = std::chrono::steady_clock::now();
+
+// Buffer of the calling thread, registered on first use.
+static trace_buffer& thread_buffer()
+{
+	thread_local trace_buffer* buffer = nullptr;
+	if (nullptr == buffer) {
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		registry.push_back(std::make_unique<trace_buffer>());
+		buffer = registry.back().get();
+		buffer->thread = registry.size();
+		buffer->events.reserve(1024);
+	}
+	return *buffer;
+}
+
+
+void trace_span::record()
+{
+	using namespace std::chrono;
+	auto end = steady_clock::now();
+	thread_buffer().events.push_back({
+		name,
+		duration_cast<nanoseconds>(start - trace_epoch).count(),
+		duration_cast<nanoseconds>(end - start).count()
+	});
+}
+
+
+// Span names are literals from the sources, but quote them properly anyway.
+static std::string json_string(const char* s)
+{
+	std::string quoted = "\"";
+	for (; *s; ++s) {
+		if (('"' == *s) || ('\\' == *s)) quoted += '\\';
+		if (static_cast<unsigned char>(*s) >= ' ') quoted += *s;
+	}
+	return quoted + "\"";
+}
+
+
+bool write_trace(const std::string& filename)
+{
+	std::ofstream out(filename);
+	if (!out) return false;
+
+	// Complete events ("X") with microsecond timestamps, and a name for each thread.
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	bool first = true;
+	out << std::fixed << std::setprecision(3);
+	for (const auto& buffer : registry) {
+		out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread
+			<< ",\"args\":{\"name\":\"thread " << buffer->thread << "\"}}";
+		first = false;
+		for (const auto& e : buffer->events) {
+			out << ",\n{\"name\":" << json_string(e.name) << ",\"cat\":\"aoc\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread
+				<< ",\"ts\":" << e.start_ns / 1e3 << ",\"dur\":" << e.duration_ns / 1e3 << "}";
+		}
+	}
+	out << "\n]}\n";
+	return static_cast<bool>(out.flush());
+}
@@ -0,0 +1,42 @@
+#ifndef _AOCTRACE_H_
+#define _AOCTRACE_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <chrono>
+#include <string>
+
+// Tracing is off unless turned on before the day solutions run.
+extern bool tracing;
+
+// Timed span of a solution phase, from construction to destruction.
+// Spans are recorded in a buffer of each thread, and written as a Chrome
+// trace when the run is done.  When tracing is off a span only checks the
+// flag.  The name must be a string literal, as only the pointer is kept.
+//
+//	{
+//		trace_span span("day05 readlines");
+//		...
+//	}
+class trace_span {
+public:
+	explicit trace_span(const char* name) : name(tracing ? name : nullptr) {
+		if (this->name) start = std::chrono::steady_clock::now();
+	}
+	~trace_span() { if (name) record(); }
+
+	trace_span(const trace_span&) = delete;
+	trace_span& operator=(const trace_span&) = delete;
+
+private:
+	void record();
+
+	const char* name;
+	std::chrono::steady_clock::time_point start;
+};
+
+// Write the spans of all threads in the Chrome/Perfetto trace event
+// format.  Returns false if the file cannot be written.
+bool write_trace(const std::string& filename);
+
+#endif /* _AOCTRACE_H_ */
@@ -0,0 +1,123 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "aoc.h"
+#include "aocarena.h"
+#include "aocbench.h"
+#include "aocgen.h"
+#include "aocvalidate.h"
+
+
+// Solve a part with an engine, timing it.
+static long timed_solve(solvefunction solve, const parsed_input& parsed, long& ns)
+{
+	using clock = std::chrono::steady_clock;
+	arena_resource arena;
+	arena_scope scope(arena);
+	auto t0 = clock::now();
+	long result = solve(parsed);
+	ns += std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count();
+	return result;
+}
+
+
+// Validate the engines of one day.  Returns the number of mismatches.
+static int validate_day(int day, const validate_options& options)
+{
+	const auto& engines = day_engines.at(day);
+	const auto& solver = day_solvers.at(day);
+	const auto& reference = engines.front();
+
+	// Totals of one scale for each part and engine, the reference first.
+	struct tally {
+		long ns = 0;
+		int mismatches = 0;
+	};
+	int mismatches = 0;
+
+	std::cout << "Day " << day << ": reference engine " << reference.name << "\n";
+	std::cout << "Part  " << std::setw(6) << "Scale" << std::setw(12) << "Bytes" << "  " << std::left << std::setw(14) << "Engine"
+		<< std::right << std::setw(14) << "Reference" << std::setw(14) << "Engine" << std::setw(12) << "Speedup" << std::setw(12) << "Mismatches" << std::endl;
+
+	for (long scale = 1; scale <= options.max_scale; scale *= 2) {
+		std::vector<tally> tallies[2] = { std::vector<tally>(engines.size()), std::vector<tally>(engines.size()) };
+		size_t bytes = 0;
+
+		for (int s = 0; s < options.seeds; ++s) {
+			unsigned long seed = default_seed + s;
+			std::ostringstream generated;
+			if (!generate_input(generated, day, scale, seed)) {
+				std::cerr << "No generator for day " << day << std::endl;
+				return 1;
+			}
+			std::string input = generated.str();
+			bytes += input.size();
+
+			arena_resource arena;
+			arena_scope scope(arena);
+			auto parsed = solver.parse(input);
+			for (int part = 1; part <= 2; ++part) {
+				auto& t = tallies[part - 1];
+				auto part_of = [part](const day_engine& e) { return (1 == part) ? e.part1 : e.part2; };
+				long expected = timed_solve(part_of(reference), *parsed, t[0].ns);
+				for (size_t e = 1; e < engines.size(); ++e) {
+					long result = timed_solve(part_of(engines[e]), *parsed, t[e].ns);
+					if (result == expected) continue;
+					++t[e].mismatches;
+					std::cout << "Mismatch: day " << day << " part " << part << " engine " << engines[e].name
+						<< ": " << result << ", expected " << expected
+						<< " (aocgen " << day << " " << scale << " " << seed << ")" << std::endl;
+				}
+			}
+		}
+
+		long reference_ns = 0;
+		for (int part = 1; part <= 2; ++part) {
+			const auto& t = tallies[part - 1];
+			reference_ns += t[0].ns;
+			for (size_t e = 1; e < engines.size(); ++e) {
+				double speedup = static_cast<double>(t[0].ns) / std::max(1L, t[e].ns);
+				std::cout << std::setw(4) << part << "  " << std::setw(6) << scale << std::setw(12) << bytes / options.seeds
+					<< "  " << std::left << std::setw(14) << engines[e].name << std::right
+					<< std::setw(14) << duration(t[0].ns) << std::setw(14) << duration(t[e].ns)
+					<< std::setw(11) << std::fixed << std::setprecision(1) << speedup << "×"
+					<< std::setw(12) << t[e].mismatches << std::endl;
+				mismatches += t[e].mismatches;
+			}
+		}
+
+		if (reference_ns > options.budget * 1e9) {
+			if (scale < options.max_scale) std::cout << "Reference engine over the " << options.budget << " s budget, stopping at scale " << scale << std::endl;
+			break;
+		}
+	}
+	std::cout << std::endl;
+
+	return mismatches;
+}
+
+
+int validate(int day, const validate_options& options)
+{
+	std::vector<int> days;
+	for (const auto& [d, engines] : day_engines) {
+		if ((0 == day) || (d == day)) days.push_back(d);
+	}
+	if (days.empty()) {
+		std::cerr << "No alternative engines for day " << day << std::endl;
+		return 1;
+	}
+
+	int mismatches = 0;
+	for (auto d : days) mismatches += validate_day(d, options);
+
+	if (mismatches > 0) std::cout << mismatches << " mismatch" << ((mismatches > 1) ? "es" : "") << std::endl;
+	else std::cout << "All engines agree with the reference" << std::endl;
+	return (mismatches > 0) ? 1 : 0;
+}
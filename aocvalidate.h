@@ -0,0 +1,24 @@
+#ifndef _AOCVALIDATE_H_
+#define _AOCVALIDATE_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+// Validate options.
+struct validate_options {
+	int seeds = 3;				// Generated inputs per scale.
+	long max_scale = 64;		// Largest generator scale.
+	double budget = 10.0;		// Seconds of reference engine time after which scales stop growing.
+};
+
+// Differential validation of the day engines: generate random inputs of
+// growing scale, parse each once and solve both parts with the reference
+// engine and every alternative engine of the day.  Mismatching results are
+// printed with the scale and seed to reproduce them with aocgen, and for
+// each scale a table row gives the total times and the speedup over the
+// reference.  Scales double until the maximum, or until the reference
+// engine takes longer than the budget for one scale.  Day 0 validates all
+// days with alternative engines.
+// Returns the process exit code, nonzero if any result mismatched.
+int validate(int day, const validate_options& options);
+
+#endif /* _AOCVALIDATE_H_ */
@@ -0,0 +1,45 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include <climits>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include "aoc.h"
+#include "aoclog.h"
+#include "aocvisual.h"
+
+
+// Open the plugin once.  A failed load is not retried.
+static void* plugin()
+{
+	static void* handle = nullptr;
+	static std::once_flag loaded;
+	std::call_once(loaded, []() {
+		// The reason the plugin next to the executable did not load, such as
+		// missing graphics libraries, is more useful than not finding it elsewhere.
+		std::string error;
+		char exe[PATH_MAX];
+		ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+		if (len > 0) {
+			std::string path(exe, len);
+			path = path.substr(0, path.rfind('/') + 1) + "aocp8g.so";
+			handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+			if ((nullptr == handle) && (0 == access(path.c_str(), F_OK))) error = dlerror();
+		}
+		if (nullptr == handle) handle = dlopen("aocp8g.so", RTLD_NOW | RTLD_LOCAL);
+		if (error.empty() && (nullptr == handle)) error = dlerror();
+		if ((nullptr == handle) && log_debug()) log_line() << "No visualisation: " << error;
+	});
+	return handle;
+}
+
+
+void* visual_function(const char* name)
+{
+	void* handle = plugin();
+	return handle ? dlsym(handle, name) : nullptr;
+}
@@ -0,0 +1,34 @@
+#ifndef _AOCVISUAL_H_
+#define _AOCVISUAL_H_
+
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+#include "aocgrid.h"
+
+// Graphical views of the day solutions are in the plugin aocp8g.so, which
+// alone links the Precessing graphics library.  It is loaded only when a
+// view is shown, so aoc2023 itself runs without any graphics libraries.
+
+// Function of the plugin by name, or nullptr if the plugin or the graphics
+// libraries it needs cannot be loaded.  The plugin is looked for next to
+// the executable first, then in the library search path.
+void* visual_function(const char* name);
+
+
+// Day 10 pipeline to draw: the pipeline tiles, and each tile as 3×3 pixels
+// set where the pipe is drawn.
+struct pipeline_view {
+	int width = 0;
+	int height = 0;
+	int scale = 2;		// Pixels per bitmap pixel.
+	int start_x = -1, start_y = -1;
+	int end_x = -1, end_y = -1;
+	int bottom_x = -1, bottom_y = -1;
+	const Grid<char>* bitmap = nullptr;
+	const Grid<char>* pipeline = nullptr;
+};
+
+// Shows the pipeline in a window until it is closed.
+extern "C" typedef void draw_pipeline_function(const pipeline_view& view);
+
+#endif /* _AOCVISUAL_H_ */
@@ -48,13 +48,20 @@ What is the sum of all of the calibration values?
 
 // Advent of Code 2023 Solutions by Arttu Kärpinlehto
 
+#include <algorithm>
 #include <map>
+#include <memory>
+#include <vector>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cctype>
 
 #include "aoc.h"
+#include "aocinput.h"
+#include "aocisa.h"
+#include "aoclog.h"
 
 // This map has the spelled out versions of digits 0-9.
 std::map<unsigned int, std::string> numbers = {
@@ -62,48 +69,153 @@ std::map<unsigned int, std::string> numbers = {
 };
 
 
-long day01(int part, std::istream& puzzle_input)
+// First and last digit of a line as a two-digit number, zero without digits.
+typedef long digits_function(std::string_view line);
+
+static long digits_scalar(std::string_view line)
 {
-	long total = 0;	// Sum of values stored here.
+	auto first = std::find_if(line.begin(), line.end(), isdigit);
+	if (line.end() == first) return 0;
+	auto last = std::find_if(line.rbegin(), line.rend(), isdigit);
+	return 10 * (*first - '0') + (*last - '0');
+}
 
-	// Parse each line of puzzle input.
-	for (std::string line; std::getline(puzzle_input, line); ) {
-		if (debug) std::cout << "Line: " << line << std::endl;
-
-		// First and last numbers of each line.
-		int first = -1;	// Negative value means "value not set".
-		int last;
-
-		// Iterate over each character of the line.
-		for (auto line_it = line.begin(); line_it != line.end(); ++line_it) {
-			auto c = *line_it;
-			if (isdigit(c)) {
-				// Every encountered number is the last one of the line.
-				last = c - '0';
-				if (-1 == first) first = last;	// Set first only when "value not set".
-			} else if (2 == part) {
-				// In part 2, also consider spelled out numbers.
-				// Try to find number strings from the line.
-				for (const auto& num : numbers) {	// num = { number, "number" }
-					// Length-limited string compare:
-					//  line[current position .. +len("number")] == "number"
-					if (strncmp(&line[std::distance(line.begin(), line_it)], num.second.c_str(), num.second.length()) == 0) {
-						// Again, every encountered number is the last one of the line.
-						last = num.first;
-						if (-1 == first) first = last;	// Set first only when "value not set".
-					}
+// Vector versions: look for the first digit a block at a time from the start
+// of the line, and for the last one from the end, while whole blocks fit in
+// the line.  The rest is checked one character at a time.
+template <size_t block, uint64_t (*digit_mask)(const char*)>
+__attribute__((always_inline))
+static inline long digits_blocks(std::string_view line)
+{
+	const char* p = line.data();
+	int first = -1, last = -1;
+	size_t pos = 0;
+	for (; (first < 0) && (pos + block <= line.size()); pos += block) {
+		if (uint64_t digits = digit_mask(p + pos)) first = p[pos + __builtin_ctzll(digits)] - '0';
+	}
+	for (; (first < 0) && (pos < line.size()); ++pos) {
+		if (isdigit(p[pos])) first = p[pos] - '0';
+	}
+	if (first < 0) return 0;
+
+	size_t end = line.size();
+	for (; (last < 0) && (end >= block); end -= block) {
+		if (uint64_t digits = digit_mask(p + end - block)) last = p[end - block + 63 - __builtin_clzll(digits)] - '0';
+	}
+	while (last < 0) {
+		--end;		// There is a digit, the first one.
+		if (isdigit(p[end])) last = p[end] - '0';
+	}
+	return 10 * first + last;
+}
+
+__attribute__((target("sse4.2")))
+static long digits_sse42(std::string_view line) { return digits_blocks<16, digit_mask16>(line); }
+
+// Most lines are shorter than 32 characters, so the wider blocks seldom fit
+// and the 16-byte version is used on the wider levels too.
+static const isa_dispatch<digits_function> line_digits { digits_scalar, digits_sse42, nullptr, nullptr };
+
+
+// Calibration value of one line of the puzzle input.
+// The part is a template parameter, so each part has a loop of its own
+// without the part check for every character.  Part 1 only needs the
+// digits, found with the kernel of the instruction set level in use.
+template <int part>
+long calibration(std::string_view line, digits_function* digits)
+{
+	if (log_trace()) log_line() << "Line: " << line;
+
+	if constexpr (1 == part) {
+		long value = digits(line);
+		if (log_trace()) log_line() << "First: " << value / 10 << ", Last: " << value % 10;
+		return value;
+	}
+
+	// First and last numbers of each line.
+	int first = -1;	// Negative value means "value not set".
+	int last;
+
+	// Iterate over each character of the line.
+	for (size_t pos = 0; pos < line.length(); ++pos) {
+		auto c = line[pos];
+		if (isdigit(c)) {
+			// Every encountered number is the last one of the line.
+			last = c - '0';
+			if (-1 == first) first = last;	// Set first only when "value not set".
+		} else if constexpr (2 == part) {
+			// In part 2, also consider spelled out numbers.
+			// Try to find number strings from the line.
+			for (const auto& num : numbers) {	// num = { number, "number" }
+				// Length-limited string compare:
+				//  line[current position .. +len("number")] == "number"
+				// The line is not null-terminated, so compare within the line only.
+				if (line.substr(pos).starts_with(num.second)) {
+					// Again, every encountered number is the last one of the line.
+					last = num.first;
+					if (-1 == first) first = last;	// Set first only when "value not set".
 				}
 			}
 		}
+	}
+
+	if (log_trace()) log_line() << "First: " << first << ", Last: " << last;
+
+	return 10 * first + last;
+}
 
-		if (debug) std::cout << "First: " << first << ", Last: " << last << std::endl;
 
-		total += 10 * first + last;
+template <int part>
+long calibrations(std::istream& puzzle_input)
+{
+	long total = 0;	// Sum of values stored here.
+	auto digits = line_digits.get();
+
+	// Parse each line of puzzle input.
+	for (std::string line; std::getline(puzzle_input, line); ) {
+		total += calibration<part>(line, digits);
+	}
+
+	return total;
+}
+
+
+long day01(int part, std::istream& puzzle_input)
+{
+	return (2 == part) ? calibrations<2>(puzzle_input) : calibrations<1>(puzzle_input);
+}
+
+
+// Parsed puzzle input: the lines, referring to the puzzle input.
+struct day01_input : parsed_input {
+	std::vector<std::string_view> lines;
+};
+
+std::unique_ptr<parsed_input> day01_parse(std::string_view puzzle_input)
+{
+	auto parsed = std::make_unique<day01_input>();
+	// Split puzzle input into lines, without copying.
+	for (auto line : lines(puzzle_input)) {
+		parsed->lines.push_back(line);
 	}
+	return parsed;
+}
 
+// Sum of calibration values of the parsed lines.
+template <int part>
+long calibrations(const day01_input& input)
+{
+	long total = 0;	// Sum of values stored here.
+	auto digits = line_digits.get();
+	for (auto line : input.lines) {
+		total += calibration<part>(line, digits);
+	}
 	return total;
 }
 
+long day01_part1(const parsed_input& input) { return calibrations<1>(static_cast<const day01_input&>(input)); }
+long day01_part2(const parsed_input& input) { return calibrations<2>(static_cast<const day01_input&>(input)); }
+
 /*
 Day 1 puzzle is very simple as it is line-oriented and the numbers are
 single-digit.  In part 1, isdigit() does all the heavy lifting, and in
@@ -112,6 +224,8 @@ part 2 the length-limited string compare strncmp() is all we need.
 The approach is very brute force, but effective.  Since we iterate over
 every character, strncmp() will automatically handle possible edge cases
 like 'twone'.  Using regular expressions is just overengineering.
+(With the memory-mapped input the lines are not null-terminated, so
+strncmp() became a bounded starts_with() compare.)
 
 Setting last value on every occurance of a number is also simple and
 effective.  Reverse string matching is not necessary.
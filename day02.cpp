@@ -95,19 +95,24 @@ What is the sum of the power of these sets?
 
 // Advent of Code 2023 Solutions by Arttu Kärpinlehto
 
+#include <memory>
+#include <vector>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cctype>
 
 #include "aoc.h"
+#include "aocinput.h"
+#include "aocparse.h"
 
 
 // Different color cubes are stored in this data structure.
 struct cubes {
 	int red, green, blue;
 
-	void set_value(std::string name, int value) {
+	void set_value(std::string_view name, int value) {
 		if (name == "red") red = value;
 		else if (name == "green") green = value;
 		else if (name == "blue") blue = value;
@@ -128,71 +133,129 @@ struct cubes {
 };
 
 // Given a string like "3 blue", sets the respective value of the cubes data structure.
-void cubeset(cubes& value, std::string s) {
+// Counts are one or two digits, too short for a vector kernel to pay off.
+void cubeset(cubes& value, std::string_view s) {
 	auto pos = s.find(' ');
-	value.set_value(s.substr(pos+1), std::stoi(s.substr(0, pos)));
+	value.set_value(s.substr(pos+1), to_number<int>(s.substr(0, pos)));
 }
 
 // Given a string like "8 green, 6 blue, 20 red", sets the values in cubes data structure.
-void fetch(cubes& value, std::string s)
+void fetch(cubes& value, std::string_view s)
 {
-	s += ",";	// Append comma to string for simpler logic.
-
 	size_t pos = 0;
 	while (pos < s.length()) {
 		// Skip possible leading spaces.
 		while (' ' == s.at(pos)) ++pos;
 		// Look for next comma in string and send a substring up to that comma to cubeset().
 		auto newpos = s.find(',', pos);
+		if (std::string_view::npos == newpos) newpos = s.length();	// Last one has no comma.
 		cubeset(value, s.substr(pos, newpos - pos));
 		// Set position after comma.
 		pos = newpos + 1;
 	}
 }
 
+// Given one line of puzzle input, return the sets of cubes fetched from the bag.
+std::vector<cubes> readgame(std::string_view line)
+{
+	std::vector<cubes> sets;
 
-long day02(int part, std::istream& puzzle_input)
+	auto pos = line.find(':') + 2;
+	while (pos < line.length()) {
+		cubes value { 0, 0, 0 };	// Set of cubes fetched from the bag.
+
+		// Look for next semicolon and send substring up to that semicolon to fetch().
+		auto newpos = line.find(';', pos);
+		if (std::string_view::npos == newpos) newpos = line.length();	// Last one has no semicolon.
+		fetch(value, line.substr(pos, newpos - pos));
+		// Set position after semicolon.
+		pos = newpos + 1;
+
+		sets.push_back(value);
+	}
+
+	return sets;
+}
+
+// Given the sets of cubes of one game, return its value for the solution:
+// game ID if the game is possible (part 1), or power of the fewest cubes (part 2).
+// The part is a template parameter, so the loop has no part checks.
+template <int part>
+long gamevalue(int gameid, const std::vector<cubes>& sets)
+{
+	bool game_ok = true;		// Game ok for part 1.
+	cubes fewest { 0, 0, 0 };	// Fewest cubes for part 2.
+
+	for (auto value : sets) {
+		if constexpr (1 == part) {
+			// Part 1: When number of cubes is not within set limits,
+			// set flag and break from loop. Game ID will not be added.
+			if (false == (game_ok = value.within_limits())) break;
+		} else {
+			// Part 2: Update the fewest cubes.
+			fewest.set_larger(value);
+		}
+	}
+
+	if constexpr (1 == part) {
+		return game_ok ? gameid : 0;
+	} else {
+		return fewest.red * fewest.green * fewest.blue;
+	}
+}
+
+
+template <int part>
+long games(std::istream& puzzle_input)
 {
 	long sum = 0;	// Solution stored here.
 
 	// Parse each line of puzzle input.
 	int gameid = 1;	// Game ID is linear so no need to parse the input.
 	for (std::string line; std::getline(puzzle_input, line); ++gameid) {
-		line += ";";	// Append semicolon to line end for simpler logic.
-
-		bool game_ok = true;		// Game ok for part 1.
-		cubes fewest { 0, 0, 0 };	// Fewest cubes for part 2.
-
-		auto pos = line.find(':') + 2;
-		while (pos < line.length()) {
-			cubes value { 0, 0, 0 };	// Set of cubes fetched from the bag.
-
-			// Look for next semicolon and send substring up to that semicolon to fetch().
-			auto newpos = line.find(';', pos);
-			fetch(value, line.substr(pos, newpos - pos));
-			// Set position after semicolon.
-			pos = newpos + 1;
-
-			if (1 == part) {
-				// Part 1: When number of cubes is not within set limits,
-				// set flag and break from loop. Game ID will not be added.
-				if (false == (game_ok = value.within_limits())) break;
-			} else {
-				// Part 2: Update the fewest cubes.
-				fewest.set_larger(value);
-			}
-		}
+		sum += gamevalue<part>(gameid, readgame(line));
+	}
 
-		if (1 == part) {
-			if (game_ok) sum += gameid;
-		} else {
-			sum += fewest.red * fewest.green * fewest.blue;
-		}
+	return sum;
+}
+
+
+long day02(int part, std::istream& puzzle_input)
+{
+	return (1 == part) ? games<1>(puzzle_input) : games<2>(puzzle_input);
+}
+
+
+// Parsed puzzle input: sets of cubes of each game, game ID is index + 1.
+struct day02_input : parsed_input {
+	std::vector<std::vector<cubes>> games;
+};
+
+std::unique_ptr<parsed_input> day02_parse(std::string_view puzzle_input)
+{
+	auto parsed = std::make_unique<day02_input>();
+	// Parse each line of puzzle input, without copying.
+	for (auto line : lines(puzzle_input)) {
+		parsed->games.push_back(readgame(line));
 	}
+	return parsed;
+}
 
+// Sum of the values of all parsed games.
+template <int part>
+long games(const day02_input& input)
+{
+	long sum = 0;	// Solution stored here.
+	int gameid = 1;	// Game ID is linear.
+	for (const auto& sets : input.games) {
+		sum += gamevalue<part>(gameid++, sets);
+	}
 	return sum;
 }
 
+long day02_part1(const parsed_input& input) { return games<1>(static_cast<const day02_input&>(input)); }
+long day02_part2(const parsed_input& input) { return games<2>(static_cast<const day02_input&>(input)); }
+
 /*
 More of a string parsing problem than anything else. Was not particularly
 difficult but annoying and time-consuming. Other languages might have been
@@ -94,6 +94,11 @@ What is the sum of all of the gear ratios in your engine schematic?
 
 // Advent of Code 2023 Solutions by Arttu Kärpinlehto
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <iostream>
 #include <string>
@@ -102,6 +107,115 @@ What is the sum of all of the gear ratios in your engine schematic?
 #include <cassert>
 
 #include "aoc.h"
+#include "aocarena.h"
+#include "aocgrid.h"
+#include "aocinput.h"
+#include "aoclog.h"
+#include "aocparse.h"
+
+// Any character other than a digit or '.' is an engine part.
+inline bool isenginepart(char c) { return ('.' != c) && !isdigit(c); }
+
+// Part numbers are stored with their location and length in the schematic.
+struct partnumber {
+	int number;
+	int x, y;
+	int length;
+};
+
+
+// Parsed puzzle input: the schematic, the part numbers, and for each
+// schematic cell the index of the part number on it, or -1.
+struct day03_input : parsed_input {
+	Grid<char> schematic;
+	Grid<int> numbered;
+	std::pmr::vector<partnumber> partnumbers { day_resource() };
+};
+
+// Reads the engine schematic from puzzle input.
+std::unique_ptr<day03_input> readschematic(std::string_view puzzle_input)
+{
+	auto parsed = std::make_unique<day03_input>();
+	auto& schematic = parsed->schematic;
+	auto& partnumbers = parsed->partnumbers;
+
+	// The border is empty space, so looking around the edges needs no checks.
+	schematic = Grid<char>::load(puzzle_input, '.');
+	parsed->numbered = Grid<int>(schematic.width(), schematic.height(), -1, -1);
+
+	// Extract the numbers of each line and mark the cells they cover.
+	for (int y = 0; y < schematic.height(); ++y) {
+		auto line = schematic.row(y);
+		for (int x = 0; x < schematic.width(); ++x) {
+			if (!isdigit(line[x])) {
+				if (log_trace() && isenginepart(line[x])) log_line() << "Engine part: " << line[x] << " at " << x << "," << y;
+				continue;
+			}
+			int end = x;
+			while ((end < schematic.width()) && isdigit(line[end])) ++end;
+			auto num = to_number<int>(std::string_view(&line[x], end - x));
+			if (log_trace()) log_line() << "Part number: " << num << " at " << x << "," << y;
+			for (int i = x; i < end; ++i) parsed->numbered(i, y) = partnumbers.size();
+			partnumbers.push_back({num, x, y, end - x});
+			x = end - 1;	// -1 because of ++x
+		}
+	}
+
+	return parsed;
+}
+
+// For part 1, iterate through all part numbers.
+// Add them to the sum if there is an engine part around them.
+long partnumbersum(const day03_input& input)
+{
+	long sum = 0;	// Solution stored here.
+
+	for (const auto& pn : input.partnumbers) {
+		bool adjacent = false;
+		for (int y = pn.y - 1; y <= pn.y + 1; ++y) {
+			for (int x = pn.x - 1; x <= pn.x + pn.length; ++x) {
+				if (isenginepart(input.schematic(x, y))) adjacent = true;
+			}
+		}
+		if (adjacent) sum += pn.number;
+	}
+
+	if (log_debug()) log_line() << "Sum: " << sum;
+
+	return sum;
+}
+
+// For part 2, iterate through all engine parts.
+// For each gear (*), look for two adjacent part numbers
+// and add their product to the sum.
+long gearratiosum(const day03_input& input)
+{
+	long sum = 0;	// Solution stored here.
+
+	for (int y = 0; y < input.schematic.height(); ++y) {
+		auto line = input.schematic.row(y);
+		for (int x = 0; x < input.schematic.width(); ++x) {
+			if ('*' != line[x]) continue;
+			// Distinct part numbers around, the first two in reading order count.
+			std::array<int, 8> found;
+			size_t count = 0;
+			for (auto n : input.numbered.neighbours(x, y)) {
+				if ((n >= 0) && (std::find(found.begin(), found.begin() + count, n) == found.begin() + count)) {
+					found[count++] = n;
+				}
+			}
+			if (count >= 2) {
+				std::sort(found.begin(), found.begin() + count);
+				sum += input.partnumbers[found[0]].number * input.partnumbers[found[1]].number;
+			}
+		}
+	}
+
+	if (log_debug()) log_line() << "Sum: " << sum;
+
+	return sum;
+}
+
 
 // Engine parts are stored with their coordinates in the engine.
 struct enginepart {
@@ -109,102 +223,94 @@ struct enginepart {
 	char symbol;
 };
 
-// Part numbers are stored with a bounding box that extends one
-// column and one line around the number.
+// Returns true when the engine part is on the box that extends one
+// column and one line around the part number.
 // +---+
 // |123|
 // +---+
-struct partnumber {
-	int number;
-	struct {
-		int x0, y0, x1, y1;
-	} box;
-
-	partnumber(int n, int x, int y) : number(n) {
-		assert(n <= 99999);	// We handle only 5 digit part numbers.
-		size_t len = 1 + (n > 9 ? 1 : 0) + (n > 99 ? 1 : 0) + (n > 999 ? 1 : 0) + (n > 9999 ? 1 : 0);
-		box.x0 = x - (x > 0 ? 1 : 0);
-		box.x1 = x + len;
-		box.y0 = y - (y > 0 ? 1 : 0);
-		box.y1 = y + 1;
-	}
+inline bool isadjacent(const partnumber& pn, const enginepart& ep)
+{
+	if ((ep.x < pn.x - 1) || (ep.x > pn.x + pn.length)) return false;
+	if ((ep.y < pn.y - 1) || (ep.y > pn.y + 1)) return false;
+	return true;
+}
 
-	// Returns true when enginepart coordinates hit the bounding box.
-	bool isadjacent(const enginepart& ep) const {
-		if ((ep.x < box.x0) || (ep.x > box.x1)) return false;
-		if ((ep.y < box.y0) || (ep.y > box.y1)) return false;
-		return true;
+// The engine parts of the schematic in reading order.
+std::pmr::vector<enginepart> engineparts(const day03_input& input)
+{
+	std::pmr::vector<enginepart> parts(day_resource());
+	for (int y = 0; y < input.schematic.height(); ++y) {
+		auto line = input.schematic.row(y);
+		for (int x = 0; x < input.schematic.width(); ++x) {
+			if (isenginepart(line[x])) parts.push_back({x, y, line[x]});
+		}
 	}
-};
-
+	return parts;
+}
 
-long day03(int puzzle_part, std::istream& puzzle_input)
+// Part 1 like partnumbersum(), but matching every part number against
+// every engine part.  This is the reference engine for validate.
+long boxpartnumbersum(const day03_input& input)
 {
 	long sum = 0;	// Solution stored here.
 
-	std::vector<partnumber> partnumbers;
-	std::vector<enginepart> engineparts;
-
-	// Parse each line of puzzle input.
-	int y = 0;
-	for (std::string line; std::getline(puzzle_input, line); ++y) {
-		for (int x = 0; auto c = line[x]; ++x) {
-			if ('.' == c) continue;
-			if (isdigit(c)) {
-				// Extract the number from position x and store into partnumbers list.
-				auto end = line.find_first_not_of("0123456789", x);
-				if (std::string::npos == end) end = line.length();	// Catch numbers that are at the very end of line.
-				auto num = std::stoi(line.substr(x, end - x));
-				partnumbers.push_back(partnumber(num, x, y));
-				if (debug) std::cout << "Part number: " << num << " at " << x << "," << y << std::endl;
-				x = end - 1;	// -1 because of ++x // potential bug location here
-			} else {
-				// Store the engine part into the list.
-				engineparts.push_back({x, y, c});
-				if (debug) std::cout << "Engine part: " << c << " at " << x << "," << y << std::endl;
+	auto parts = engineparts(input);
+	for (const auto& pn : input.partnumbers) {
+		for (const auto& ep : parts) {
+			if (isadjacent(pn, ep)) {
+				sum += pn.number;
+				break;
 			}
 		}
 	}
 
-	if (1 == puzzle_part) {
-		// For part 1, iterate through all part numbers.
-		// Add them to the sum if there is an adjacent engine part.
-		for (const auto& pn_it : partnumbers) {
-			for (const auto& ep_it : engineparts) {
-				if (true == pn_it.isadjacent(ep_it)) {
-					sum += pn_it.number;
-					break;
-				}
-			}
-		}
-	} else {
-		// For part 2, iterate through all engine parts.
-		// For each gear (*), look for two adjacent part numbers
-		// and add their product to the sum.
-		for (const auto& ep_it : engineparts) {
-			if ('*' == ep_it.symbol) {
-				int first = -1;	// negative value for "value not set"
-				int second = -1;
-				for (const auto& pn_it : partnumbers) {
-					if (true == pn_it.isadjacent(ep_it)) {
-						if (-1 == first) {
-							first = pn_it.number;
-						} else if (-1 == second) {
-							second = pn_it.number;
-							sum += first * second;
-							break;
-						}
-					}
-				}
+	return sum;
+}
+
+// Part 2 like gearratiosum(), but matching every gear against every part
+// number.  This is the reference engine for validate.
+long boxgearratiosum(const day03_input& input)
+{
+	long sum = 0;	// Solution stored here.
+
+	for (const auto& ep : engineparts(input)) {
+		if ('*' != ep.symbol) continue;
+		int first = -1;	// negative value for "value not set"
+		for (const auto& pn : input.partnumbers) {
+			if (!isadjacent(pn, ep)) continue;
+			if (-1 == first) {
+				first = pn.number;
+			} else {
+				sum += first * pn.number;
+				break;
 			}
 		}
 	}
 
-	if (debug) std::cout << "Sum: " << sum << std::endl;
-
 	return sum;
 }
 
+
+long day03(int puzzle_part, std::istream& puzzle_input)
+{
+	std::string text(std::istreambuf_iterator<char>(puzzle_input), {});
+	auto parsed = readschematic(text);
+	return (1 == puzzle_part) ? partnumbersum(*parsed) : gearratiosum(*parsed);
+}
+
+
+std::unique_ptr<parsed_input> day03_parse(std::string_view puzzle_input)
+{
+	return readschematic(puzzle_input);
+}
+
+long day03_part1(const parsed_input& input) { return partnumbersum(static_cast<const day03_input&>(input)); }
+long day03_part2(const parsed_input& input) { return gearratiosum(static_cast<const day03_input&>(input)); }
+
+// Bounding box engine, the reference for the one above.
+long day03_box_part1(const parsed_input& input) { return boxpartnumbersum(static_cast<const day03_input&>(input)); }
+long day03_box_part2(const parsed_input& input) { return boxgearratiosum(static_cast<const day03_input&>(input)); }
+
 /*
 Like many AoC puzzles, this is about how do you store the input data
 so that it is most convenient to process.
@@ -213,4 +319,6 @@ is crude, but at least with these data sizes it's not a performance issue.
 Part numbers and engine parts could be mapped with y so that seeking
 adjacent parts would be faster (initial code actually had that but it
 added complexity and arguably no visible benefit).
+Later moved the schematic into a Grid with the index of the part number on
+each cell, so both parts only look at the cells around a number or a gear.
 */
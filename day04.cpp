@@ -100,104 +100,160 @@ Process all of the original and copied scratchcards until no more scratchcards a
 
 #include <algorithm>
 #include <set>
+#include <deque>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cctype>
 #include <cmath>
 
 #include "aoc.h"
+#include "aocarena.h"
+#include "aocinput.h"
+#include "aoclog.h"
+#include "aocparse.h"
 
 // Scratch cards are stored in this data structure.
 struct scratchcard {
-	long count;		// Number of cards of this type.
 	int matches;	// Number of matches this card has.
-	std::vector<int>	winning;	// List of winning numbers.
-	std::vector<int>	dealt;		// List of my numbers.
+	std::pmr::vector<int>	winning { day_resource() };	// List of winning numbers.
+	std::pmr::vector<int>	dealt { day_resource() };		// List of my numbers.
 };
 
 // Given string like "1 2 3", pushes values 1, 2, and 3 to the vector.
-void numstovec(std::vector<int>& vec, std::string s)
+void numstovec(std::pmr::vector<int>& vec, std::string_view s)
 {
-	std::istringstream ss;
-	ss.str(s);
-	for (std::string num; std::getline(ss, num, ' '); ) {
-		if (num.length() > 0) {	// Input can have consecutive spaces, skip them.
-			vec.push_back(std::stoi(num));
+	parse_numbers(s, vec);
+}
+
+// Count matches of the card. Matches are used in both parts.
+void countmatches(scratchcard& card)
+{
+	int matches = 0;
+	for (const auto deal : card.dealt) {
+		if (std::find(card.winning.begin(), card.winning.end(), deal) != card.winning.end()) {
+			++matches;
 		}
 	}
+	card.matches = matches;
 }
 
+// Given one line of puzzle input, return the scratch card.
+scratchcard readcard(std::string_view line)
+{
+	if (log_trace()) log_line() << "Line: " << line;
+	scratchcard newcard;
+	// Separate winning numbers and dealt numbers.
+	auto colon = line.find(':');	// No need to parse the card number.
+	auto bar = line.find('|', colon);
+	numstovec(newcard.winning, line.substr(colon + 1, bar - colon - 1));
+	numstovec(newcard.dealt, line.substr(bar + 1));
+	countmatches(newcard);
+	return newcard;
+}
 
-long day04(int puzzle_part, std::istream& puzzle_input)
+// Part 1: Count the points total.
+long points(const std::pmr::map<int, scratchcard>& cards)
 {
 	long sum = 0;	// Solution stored here.
-
-	// Store all scratch cards here, map key is the card number.
-	std::map<int, scratchcard> cards;
-
-	// Parse each line of puzzle input.
-	int num = 1;	// For card number.
-	for (std::string line; std::getline(puzzle_input, line); ++num) {
-		if (debug) std::cout << "Line: " << line << std::endl;
-		scratchcard newcard;
-		// Separate winning numbers and dealt numbers.
-		std::istringstream s;
-		s.str(line);
-		std::string dummy, card_win, card_deal;
-		std::getline(s, dummy, ':');	// No need to parse the card number.
-		std::getline(s, card_win, '|');
-		std::getline(s, card_deal);
-		numstovec(newcard.winning, card_win);
-		numstovec(newcard.dealt, card_deal);
-		// Initially we have only one card of each.
-		newcard.count = 1;
-		cards.insert({num, newcard});
+	for (const auto& card : cards) {
+		auto matches = card.second.matches;
+		sum += (matches > 0) ? pow(2, matches - 1) : 0;
 	}
+	if (log_debug()) log_line() << "Sum: " << sum;
+	return sum;
+}
+
+// Part 2: Count the total number of cards, originals and copies.
+long copies(const std::pmr::map<int, scratchcard>& cards)
+{
+	long sum = 0;	// Solution stored here.
 
-	// Count matches per card. This is also used in part 2.
-	if (true) {
-		for (auto& card : cards) {
-			int matches = 0;
-			for (const auto deal : card.second.dealt) {
-				if (std::find(card.second.winning.begin(), card.second.winning.end(), deal) != card.second.winning.end()) {
-					++matches;
+	// Number of cards of each type, in card order.
+	// Initially we have only one card of each.
+	std::pmr::vector<long> count(cards.size(), 1, day_resource());
+
+	size_t i = 0;
+	for (auto card = cards.begin(); card != cards.end(); ++card, ++i) {
+		if (log_trace()) log_line() << "Card: " << card->first << " Count: " << count[i];
+		// Repeat the current card as per card count.
+		for (auto c = 0; c < count[i]; ++c) {
+			// Update the count for next 'matches' cards.
+			for (auto m = 0; m < card->second.matches; ++m) {
+				auto up = i + 1 + m;	// Next card.
+				if (up < count.size()) {	// Do not go over.
+					if (log_trace()) log_line() << "Updating card " << card->first + 1 + m;
+					count[up] += 1;
 				}
 			}
-			card.second.matches = matches;
-			// Count the points total for part 1 only.
-			if (1 == puzzle_part) sum += (matches > 0) ? pow(2, matches - 1) : 0;
 		}
+		// Now we can update the total card sum with current card count.
+		sum += count[i];
 	}
-	
-	if (2 == puzzle_part) {
-		for (auto card = cards.begin(); card != cards.end(); ++card) {
-			if (debug) std::cout << "Card: " << card->first << " Count: " << card->second.count << std::endl;
-			// Repeat the current card as per card count.
-			for (auto c = 0; c < card->second.count; ++c) {
-				auto upcard = card;
-				++upcard;	// Next card.
-				// Update the count for next 'matches' cards.
-				for (auto m = 0; m < card->second.matches; ++m) {
-					if (upcard != cards.end()) {	// Do not go over.
-						if (debug) std::cout << "Updating card " << upcard->first << std::endl;
-						upcard->second.count += 1;
-						++upcard;
-					}
-				}
-			}
-			// Now we can update the total card sum with current card count.
-			sum += card->second.count;
+
+	if (log_debug()) log_line() << "Sum: " << sum;
+
+	return sum;
+}
+
+
+// Reads the cards one line at a time.  Part 2 only needs to remember the
+// copies won for the next cards, so memory use does not grow with the input.
+long day04(int puzzle_part, std::istream& puzzle_input)
+{
+	long sum = 0;	// Solution stored here.
+
+	// Copies won for the next cards, front is the current card.
+	std::deque<long> won;
+
+	// Parse each line of puzzle input.
+	for (std::string line; std::getline(puzzle_input, line); ) {
+		auto matches = readcard(line).matches;
+		if (1 == puzzle_part) {
+			sum += (matches > 0) ? (1L << (matches - 1)) : 0;
+			continue;
+		}
+		// The original card and its copies.
+		long count = 1;
+		if (!won.empty()) {
+			count += won.front();
+			won.pop_front();
 		}
+		// Each of them wins a copy of the next 'matches' cards.
+		if (won.size() < static_cast<size_t>(matches)) won.resize(matches, 0);
+		for (int m = 0; m < matches; ++m) won[m] += count;
+		sum += count;
 	}
 
-	if (debug) std::cout << "Sum: " << sum << std::endl;
-
+	if (log_debug()) log_line() << "Sum: " << sum;
 	return sum;
 }
 
+
+// Parsed puzzle input: all scratch cards, map key is the card number.
+struct day04_input : parsed_input {
+	std::pmr::map<int, scratchcard> cards { day_resource() };
+};
+
+std::unique_ptr<parsed_input> day04_parse(std::string_view puzzle_input)
+{
+	auto parsed = std::make_unique<day04_input>();
+	// Parse each line of puzzle input, without copying.
+	int num = 1;	// For card number.
+	for (auto line : lines(puzzle_input)) {
+		parsed->cards.insert({num++, readcard(line)});
+	}
+	return parsed;
+}
+
+long day04_part1(const parsed_input& input) { return points(static_cast<const day04_input&>(input).cards); }
+long day04_part2(const parsed_input& input) { return copies(static_cast<const day04_input&>(input).cards); }
+
 /*
 -- Implementation 1 notes: --
 Advent of STL? Anyways, this version with straightforward reinsert of
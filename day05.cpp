@@ -181,26 +181,38 @@ to any of the initial seed numbers?
 #include <algorithm>
 #include <functional>
 #include <array>
-#include <set>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
 #include <vector>
 #include <iostream>
-#include <sstream>
 #include <string>
 #include <cstring>
 #include <cctype>
 #include <cmath>
+#include <climits>
 
-#include <thread>
+#include <immintrin.h>
 
 #include "aoc.h"
+#include "aocarena.h"
+#include "aocinput.h"
+#include "aocisa.h"
+#include "aoclog.h"
+#include "aocparse.h"
+#include "aocserial.h"
+#include "aoctrace.h"
 
 
 // Each something-to-something map is stored in this data structure.
+// Binary input has these as they are, so the layout is three 64-bit words.
 struct a_to_b {
 	// Some of these values are pre-calculated for marginally faster execution.
-	const long src_begin;
-	const long src_end;
-	const long offset;
+	long src_begin;
+	long src_end;
+	long offset;
 
 	a_to_b(long s, long d, long l) : src_begin(s), src_end(s + l), offset(d - s) {}
 
@@ -217,12 +229,23 @@ struct a_to_b {
 		return offset + i;
 	}
 
-	// Needed for std::set
+	// Maps are kept sorted by source.
 	friend inline bool operator<(const a_to_b& lhs, const a_to_b& rhs) { return lhs.src_begin < rhs.src_begin; }
 };
+static_assert(std::is_trivially_copyable_v<a_to_b> && (sizeof(a_to_b) == 3 * sizeof(int64_t)));
+
+// The seven a_to_b maps of the almanac, one after another, each sorted by
+// source.  Map m is the pieces from first[m] up to first[m + 1].
+struct almanac_maps {
+	std::span<const a_to_b> pieces;
+	std::span<const long> first;
+
+	static constexpr size_t size() { return 7; }
+	std::span<const a_to_b> operator[](size_t m) const { return pieces.subspan(first[m], first[m + 1] - first[m]); }
+};
 
 // For input value look_for, return the destination value using a_to_b_map.
-long findmatch(const std::set<a_to_b>& a_to_b_map, const long look_for) {
+long findmatch(std::span<const a_to_b> a_to_b_map, const long look_for) {
 	for (const auto& m : a_to_b_map) {
 		if (m.match(look_for)) {
 			return m.destination(look_for);
@@ -231,39 +254,42 @@ long findmatch(const std::set<a_to_b>& a_to_b_map, const long look_for) {
 	return look_for;
 }
 
-// Reads puzzle_input lines and inserts values to given a_to_b set.
-void readlines(std::istream& puzzle_input, std::set<a_to_b>& output) {
+// Reads puzzle_input lines and appends them to the pieces as one map,
+// sorted by source.  Of pieces with the same source start, the first one
+// read is kept.
+void readlines(std::istream& puzzle_input, std::pmr::vector<a_to_b>& pieces) {
+	trace_span span("day05 readlines");
+	auto first = pieces.size();
 	for (std::string line; std::getline(puzzle_input, line); ) {
 		if (0 == line.length()) break;	// Stop when empty line encountered.
 
-		std::stringstream ss;
-		ss.str(line);
-		std::string s;
-		std::getline(ss, s, ' ');
-		long dest_start = std::stol(s);
-		std::getline(ss, s, ' ');
-		long src_start = std::stol(s);
-		std::getline(ss, s);
-		long len = std::stol(s);
-		output.insert({src_start, dest_start, len});
+		number_scanner scan(line);
+		long dest_start = 0, src_start = 0, len = 0;
+		scan.next(dest_start);
+		scan.next(src_start);
+		scan.next(len);
+		pieces.push_back({src_start, dest_start, len});
 	}
+	auto abmap = pieces.begin() + first;
+	std::stable_sort(abmap, pieces.end());
+	pieces.erase(std::unique(abmap, pieces.end(), [](const a_to_b& lhs, const a_to_b& rhs) { return lhs.src_begin == rhs.src_begin; }), pieces.end());
 	return;
 }
 
 // Reads puzzle_input and consumes the given header line,
 // moving the input pointer to the first line of map values.
 void skiptoheader(std::istream& puzzle_input, std::string header) {
+	trace_span span("day05 skiptoheader");
 	std::string line;
 	while (std::getline(puzzle_input, line)) {
 		if (header == line) break;
 	}
-	if (debug) std::cout << "Skipped to: " << line << std::endl;
+	if (log_debug()) log_line() << "Skipped to: " << line;
 	return;
 }
 
-// This is not used anymore, but would traverse the a_to_b maps
-// given in an array to find a location for the seed.
-long location(const std::array<std::set<a_to_b>, 7>& abmaps, const long seed) {
+// Traverse the a_to_b maps given in an array to find a location for the seed.
+long location(const almanac_maps& abmaps, const long seed) {
 	return findmatch(abmaps[6],
 	findmatch(abmaps[5],
 	findmatch(abmaps[4],
@@ -273,126 +299,315 @@ long location(const std::array<std::set<a_to_b>, 7>& abmaps, const long seed) {
 	findmatch(abmaps[0], seed)))))));
 }
 
-// All a_to_b maps are global as we use them in rangelowest() function.
-std::set<a_to_b>	seed_to_soil;
-std::set<a_to_b>	soil_to_fertilizer;
-std::set<a_to_b>	fertilizer_to_water;
-std::set<a_to_b>	water_to_light;
-std::set<a_to_b>	light_to_temperature;
-std::set<a_to_b>	temperature_to_humidity;
-std::set<a_to_b>	humidity_to_location;
-
 // Finds the lowest location for given seed range.
 // The lowest value is both returned and assigned to the calling argument.
-long rangelowest(long seed_first, long seed_end, long& lowest) {
-	if (debug) std::cout << "Seeds " << seed_first << "-" << seed_end << ": " << seed_end - seed_first << std::endl;
+long rangelowest(const almanac_maps& abmaps, long seed_first, long seed_end, long& lowest) {
+	trace_span span("day05 rangelowest");
+	if (log_debug()) log_line() << "Seeds " << seed_first << "-" << seed_end << ": " << seed_end - seed_first;
 
 	lowest = __LONG_MAX__;
 	for (auto seed = seed_first; seed < seed_end; ++seed) {
-		lowest = std::min(lowest, findmatch(humidity_to_location,
-			findmatch(temperature_to_humidity,
-			findmatch(light_to_temperature,
-			findmatch(water_to_light,
-			findmatch(fertilizer_to_water,
-			findmatch(soil_to_fertilizer,
-			findmatch(seed_to_soil, seed))))))));
+		lowest = std::min(lowest, location(abmaps, seed));
 	}
 
-	if (debug) std::cout << "Lowest: " << lowest << std::endl;
+	if (log_debug()) log_line() << "Lowest: " << lowest;
 	return lowest;
 }
 
+// Finds the lowest location for given seed range like rangelowest(), but
+// maps whole ranges instead of single seeds.  Each map splits a range at the
+// edges of its pieces, so the work depends on the number of pieces rather
+// than on the number of seeds.
+long splitlowest(const almanac_maps& abmaps, long seed_first, long seed_end, long& lowest) {
+	trace_span span("day05 splitlowest");
+	std::pmr::vector<std::pair<long, long>> ranges({{seed_first, seed_end}}, day_resource());
+	std::pmr::vector<std::pair<long, long>> next { day_resource() };
+
+	for (size_t m = 0; m < abmaps.size(); ++m) {
+		auto abmap = abmaps[m];
+		next.clear();
+		for (auto [first, end] : ranges) {
+			while (first < end) {
+				// The piece starting at or before first, if any, and the one after it.
+				auto after = std::upper_bound(abmap.begin(), abmap.end(), a_to_b(first, first, 0));
+				auto piece = (abmap.begin() == after) ? abmap.end() : std::prev(after);
+				if ((abmap.end() != piece) && piece->match(first)) {
+					auto split = std::min(end, piece->src_end);
+					next.push_back({piece->destination(first), piece->destination(split)});
+					first = split;
+				} else {
+					// Unmapped numbers up to the next piece stay as they are.
+					auto split = (abmap.end() == after) ? end : std::min(end, after->src_begin);
+					next.push_back({first, split});
+					first = split;
+				}
+			}
+		}
+		std::swap(ranges, next);
+	}
 
-long day05(int puzzle_part, std::istream& puzzle_input)
+	lowest = __LONG_MAX__;
+	for (const auto& range : ranges) lowest = std::min(lowest, range.first);
+
+	if (log_debug()) log_line() << "Seeds " << seed_first << "-" << seed_end << ": " << ranges.size() << " ranges, lowest: " << lowest;
+	return lowest;
+}
+
+// Lowest location of the seeds in [seed_first, seed_end).
+typedef long lowest_function(const almanac_maps& maps, long seed_first, long seed_end);
+
+static long lowest_scalar(const almanac_maps& maps, long seed_first, long seed_end)
 {
-	long lowest = __LONG_MAX__;	// Solution stored here.
+	long lowest = LONG_MAX;
+	for (auto seed = seed_first; seed < seed_end; ++seed) lowest = std::min(lowest, location(maps, seed));
+	return lowest;
+}
+
+// Vector versions: map 2, 4 or 8 consecutive seeds at a time through every
+// piece of each map, until all of them are mapped.  A seed is moved by the
+// first piece that has it, like findmatch() does, and the seeds left over
+// are mapped one at a time.
+__attribute__((target("sse4.2")))
+static long lowest_sse42(const almanac_maps& maps, long seed_first, long seed_end)
+{
+	__m128i lowest = _mm_set1_epi64x(LONG_MAX);
+	long seed = seed_first;
+	for (; seed + 2 <= seed_end; seed += 2) {
+		__m128i v = _mm_add_epi64(_mm_set1_epi64x(seed), _mm_set_epi64x(1, 0));
+		for (size_t m = 0; m < 7; ++m) {
+			__m128i out = v, mapped = _mm_setzero_si128();
+			for (long i = maps.first[m]; i < maps.first[m + 1]; ++i) {
+				// In the piece: begin is not above the seed and end is, and not mapped yet.
+				__m128i below = _mm_or_si128(_mm_cmpgt_epi64(_mm_set1_epi64x(maps.pieces[i].src_begin), v), mapped);
+				__m128i in = _mm_andnot_si128(below, _mm_cmpgt_epi64(_mm_set1_epi64x(maps.pieces[i].src_end), v));
+				out = _mm_add_epi64(out, _mm_and_si128(in, _mm_set1_epi64x(maps.pieces[i].offset)));
+				mapped = _mm_or_si128(mapped, in);
+				if (0xffff == _mm_movemask_epi8(mapped)) break;
+			}
+			v = out;
+		}
+		lowest = _mm_blendv_epi8(lowest, v, _mm_cmpgt_epi64(lowest, v));
+	}
+	long lanes[2];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), lowest);
+	return std::min({ lanes[0], lanes[1], lowest_scalar(maps, seed, seed_end) });
+}
+
+__attribute__((target("avx2")))
+static long lowest_avx2(const almanac_maps& maps, long seed_first, long seed_end)
+{
+	__m256i lowest = _mm256_set1_epi64x(LONG_MAX);
+	long seed = seed_first;
+	for (; seed + 4 <= seed_end; seed += 4) {
+		__m256i v = _mm256_add_epi64(_mm256_set1_epi64x(seed), _mm256_setr_epi64x(0, 1, 2, 3));
+		for (size_t m = 0; m < 7; ++m) {
+			__m256i out = v, mapped = _mm256_setzero_si256();
+			for (long i = maps.first[m]; i < maps.first[m + 1]; ++i) {
+				__m256i below = _mm256_or_si256(_mm256_cmpgt_epi64(_mm256_set1_epi64x(maps.pieces[i].src_begin), v), mapped);
+				__m256i in = _mm256_andnot_si256(below, _mm256_cmpgt_epi64(_mm256_set1_epi64x(maps.pieces[i].src_end), v));
+				out = _mm256_add_epi64(out, _mm256_and_si256(in, _mm256_set1_epi64x(maps.pieces[i].offset)));
+				mapped = _mm256_or_si256(mapped, in);
+				if (-1 == _mm256_movemask_epi8(mapped)) break;
+			}
+			v = out;
+		}
+		lowest = _mm256_blendv_epi8(lowest, v, _mm256_cmpgt_epi64(lowest, v));
+	}
+	long lanes[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), lowest);
+	return std::min({ lanes[0], lanes[1], lanes[2], lanes[3], lowest_scalar(maps, seed, seed_end) });
+}
+
+__attribute__((target("avx512f")))
+static long lowest_avx512(const almanac_maps& maps, long seed_first, long seed_end)
+{
+	__m512i lowest = _mm512_set1_epi64(LONG_MAX);
+	long seed = seed_first;
+	for (; seed + 8 <= seed_end; seed += 8) {
+		__m512i v = _mm512_add_epi64(_mm512_set1_epi64(seed), _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+		for (size_t m = 0; m < 7; ++m) {
+			__m512i out = v;
+			__mmask8 mapped = 0;
+			for (long i = maps.first[m]; i < maps.first[m + 1]; ++i) {
+				__mmask8 in = _mm512_cmpge_epi64_mask(v, _mm512_set1_epi64(maps.pieces[i].src_begin))
+					& _mm512_cmplt_epi64_mask(v, _mm512_set1_epi64(maps.pieces[i].src_end)) & ~mapped;
+				out = _mm512_mask_add_epi64(out, in, out, _mm512_set1_epi64(maps.pieces[i].offset));
+				mapped |= in;
+				if (0xff == mapped) break;
+			}
+			v = out;
+		}
+		lowest = _mm512_min_epi64(lowest, v);
+	}
+	return std::min<long>(_mm512_reduce_min_epi64(lowest), lowest_scalar(maps, seed, seed_end));
+}
+
+static const isa_dispatch<lowest_function> seed_lowest { lowest_scalar, lowest_sse42, lowest_avx2, lowest_avx512 };
+
+// Finds the lowest location for given seed range like rangelowest(), seed
+// by seed, but with the vector kernel of the instruction set level in use.
+long vectorlowest(const almanac_maps& maps, long seed_first, long seed_end, long& lowest) {
+	trace_span span("day05 vectorlowest");
+	lowest = seed_lowest.get()(maps, seed_first, seed_end);
+	if (log_debug()) log_line() << "Seeds " << seed_first << "-" << seed_end << ": " << isa_name(current_isa()) << ", lowest: " << lowest;
+	return lowest;
+}
 
-	//std::set<long> seeds;	// Seeds were just a set for part 1.
-	std::map<long, long>	seedranges;	// For part 2, seed ranges.
+// Function type of rangelowest() and splitlowest().
+typedef std::function<long(const almanac_maps&, long, long, long&)> rangefunction;
 
-	// Array used in threading version.
-	//std::array<std::set<a_to_b>, 7> a_to_b_maps;
+
+// Parsed puzzle input: seed numbers and a_to_b maps, solved in place
+// from a binary input.
+struct day05_input : parsed_input {
+	std::span<const long> seeds;	// Seed numbers as they are, meaning depends on the puzzle part.
+	almanac_maps a_to_b_maps;
+	std::pmr::vector<long> parsed_seeds { day_resource() };
+	std::pmr::vector<a_to_b> parsed_pieces { day_resource() };
+	std::pmr::vector<long> parsed_first { day_resource() };
+};
+
+// Reads the almanac from puzzle input.
+std::unique_ptr<day05_input> readalmanac(std::istream& puzzle_input)
+{
+	auto parsed = std::make_unique<day05_input>();
+	auto& pieces = parsed->parsed_pieces;
+	auto& first = parsed->parsed_first;
 
 	// Parse first line of puzzle input, the seeds.
+	std::string line;
+	std::getline(puzzle_input, line);
+	parse_numbers(line, parsed->parsed_seeds);
+
+	// The maps in the order of traversal.
+	for (auto header : { "seed-to-soil map:", "soil-to-fertilizer map:", "fertilizer-to-water map:", "water-to-light map:",
+			"light-to-temperature map:", "temperature-to-humidity map:", "humidity-to-location map:" }) {
+		first.push_back(pieces.size());
+		skiptoheader(puzzle_input, header);
+		readlines(puzzle_input, pieces);
+	}
+	first.push_back(pieces.size());
+
+	parsed->seeds = parsed->parsed_seeds;
+	parsed->a_to_b_maps = { pieces, first };
+	return parsed;
+}
+
+// Finds the lowest location for the seeds of the almanac, searching each
+// seed range with the given function.  By default the ranges are split at
+// the map pieces, so the work does not depend on the number of seeds.
+long lowestlocation(int puzzle_part, const day05_input& input, rangefunction rangelowest = splitlowest)
+{
+	long lowest = __LONG_MAX__;	// Solution stored here.
+
+	std::pmr::map<long, long>	seedranges { day_resource() };	// For part 2, seed ranges.
+
+	const auto& a_to_b_maps = input.a_to_b_maps;
+
 	if (1 == puzzle_part) {
-		std::string line;
-		std::getline(puzzle_input, line);
-		std::stringstream ss;
-		ss.str(line);
-		for (std::string s; std::getline(ss, s, ' '); ) {
-			if (isdigit(s[0])) {
-				auto n = std::stol(s);
-				seedranges.insert({n, n});
-			}
+		// Each seed is a range of one.
+		for (auto n : input.seeds) {
+			seedranges.insert({n, n});
 		}
 	} else {
-		std::string line;
-		std::getline(puzzle_input, line);
-		std::stringstream ss;
-		ss.str(line);
+		// Seeds come in pairs of range start and length.
 		long n, m;
 		bool flippyfloppy = true;
-		for (std::string s; std::getline(ss, s, ' '); ) {
-			if (isdigit(s[0])) {
-				if (flippyfloppy) {
-					n = std::stol(s);
-				} else {
-					m = std::stol(s);
-					seedranges.insert({n, n + m - 1});
-				}
-				flippyfloppy ^= 1;
+		for (auto s : input.seeds) {
+			if (flippyfloppy) {
+				n = s;
+			} else {
+				m = s;
+				seedranges.insert({n, n + m - 1});
 			}
+			flippyfloppy ^= 1;
 		}
 	}
-	if (debug) {
-		std::cout << "Seeds: ";
-		for (auto n = seedranges.begin(); n != seedranges.end(); ++n) std::cout << n->first << "-" << n->second << ",";
-		std::cout << std::endl;
+	if (log_debug()) {
+		log_line line;
+		line << "Seeds: ";
+		for (auto n = seedranges.begin(); n != seedranges.end(); ++n) line << n->first << "-" << n->second << ",";
 	}
-
-	skiptoheader(puzzle_input, "seed-to-soil map:");
-	readlines(puzzle_input, seed_to_soil);
-	skiptoheader(puzzle_input, "soil-to-fertilizer map:");
-	readlines(puzzle_input, soil_to_fertilizer);
-	skiptoheader(puzzle_input, "fertilizer-to-water map:");
-	readlines(puzzle_input, fertilizer_to_water);
-	skiptoheader(puzzle_input, "water-to-light map:");
-	readlines(puzzle_input, water_to_light);
-	skiptoheader(puzzle_input, "light-to-temperature map:");
-	readlines(puzzle_input, light_to_temperature);
-	skiptoheader(puzzle_input, "temperature-to-humidity map:");
-	readlines(puzzle_input, temperature_to_humidity);
-	skiptoheader(puzzle_input, "humidity-to-location map:");
-	readlines(puzzle_input, humidity_to_location);
-	if (debug) std::cout << "Seed ranges: " << seedranges.size() << std::endl;
+	if (log_debug()) log_line() << "Seed ranges: " << seedranges.size();
 
 	long low;	// Dummy, but needed to call rangelowest().
 	for (const auto& seedrange : seedranges) {
-		lowest = std::min(lowest, rangelowest(seedrange.first, seedrange.second + 1, low));
+		lowest = std::min(lowest, rangelowest(a_to_b_maps, seedrange.first, seedrange.second + 1, low));
 	}
-	// Threaded version, not particularly fast for some reason.
-	// long* lows = new long[50];
-	// std::thread* threads = new std::thread[50];
-	// int t = 0;
-	// for (const auto& seedrange : seedranges) {
-		// threads[t] = std::thread(rangelowest, seedrange.first, seedrange.second + 1, std::ref(lows[t]));
-		// if (debug) std::cout << "Thread " << t << " created." << std::endl;
-		// ++t;
-	// }
-	// for (auto i = 0; i < t; ++i) {
-	// 	threads[i].join();
-	// 	if (debug) std::cout << "Thread " << i << " ended." << std::endl;
-	// 	long low;
-	// 	lowest = std::min(lowest, lows[i]);
-	// }
-	//delete[] threads;
-	//delete[] lows;
-
-	if (debug) std::cout << "Lowest: " << lowest << std::endl;
+
+	if (log_debug()) log_line() << "Lowest: " << lowest;
 
 	return lowest;
 }
 
+
+long day05(int puzzle_part, std::istream& puzzle_input)
+{
+	auto parsed = readalmanac(puzzle_input);
+	return lowestlocation(puzzle_part, *parsed);
+}
+
+
+// Parsed state for the cache and binary input: the seeds, where each map
+// starts, then the pieces of all maps as source begin, end and offset.
+void day05_save(const parsed_input& input, std::string& out)
+{
+	const auto& parsed = static_cast<const day05_input&>(input);
+	const auto& abmaps = parsed.a_to_b_maps;
+	serial_writer w(out);
+	w.put_all(parsed.seeds);
+	w.put_all(abmaps.first);
+	w.put(abmaps.pieces.size());
+	for (const auto& m : abmaps.pieces) {
+		w.put(m.src_begin);
+		w.put(m.src_end);
+		w.put(m.offset);
+	}
+}
+
+std::unique_ptr<parsed_input> day05_load(std::string_view data)
+{
+	auto parsed = std::make_unique<day05_input>();
+	auto& abmaps = parsed->a_to_b_maps;
+	serial_reader r(data);
+	r.get_span(parsed->seeds);
+	r.get_span(abmaps.first);
+	r.get_span(abmaps.pieces);
+	if (!r.at_end()) return nullptr;
+	// Maps follow each other and cover all pieces, and each is sorted by source.
+	const auto& first = abmaps.first;
+	if ((abmaps.size() + 1 != first.size()) || (0 != first.front()) || (first.back() != static_cast<long>(abmaps.pieces.size()))) return nullptr;
+	for (size_t m = 0; m < abmaps.size(); ++m) {
+		if (first[m] > first[m + 1]) return nullptr;
+		auto abmap = abmaps[m];
+		for (size_t i = 0; i < abmap.size(); ++i) {
+			if ((abmap[i].src_begin > abmap[i].src_end) || ((i > 0) && (abmap[i - 1].src_begin >= abmap[i].src_begin))) return nullptr;
+		}
+	}
+	return parsed;
+}
+
+std::unique_ptr<parsed_input> day05_parse(std::string_view puzzle_input)
+{
+	std::string_view payload;
+	if (binary_payload(puzzle_input, 5, payload)) return valid_binary(day05_load(payload));
+
+	membuf buf(puzzle_input);
+	std::istream is(&buf);
+	return readalmanac(is);
+}
+
+long day05_part1(const parsed_input& input) { return lowestlocation(1, static_cast<const day05_input&>(input)); }
+long day05_part2(const parsed_input& input) { return lowestlocation(2, static_cast<const day05_input&>(input)); }
+
+// Seed by seed brute force engine, the reference for the others.
+long day05_brute_part1(const parsed_input& input) { return lowestlocation(1, static_cast<const day05_input&>(input), rangelowest); }
+long day05_brute_part2(const parsed_input& input) { return lowestlocation(2, static_cast<const day05_input&>(input), rangelowest); }
+
+// Vectorised brute force engine, validated against the seed by seed one.
+long day05_vector_part1(const parsed_input& input) { return lowestlocation(1, static_cast<const day05_input&>(input), vectorlowest); }
+long day05_vector_part2(const parsed_input& input) { return lowestlocation(2, static_cast<const day05_input&>(input), vectorlowest); }
+
 /*
 Input parsing was not too complicated, but the large data management in
 part 2 was. First implementation part 2 too 32m 21s non-optimised.
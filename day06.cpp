@@ -128,6 +128,7 @@ How many ways can you beat the record in this one much longer race?
 #include <functional>
 #include <array>
 #include <set>
+#include <memory>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -139,6 +140,9 @@ How many ways can you beat the record in this one much longer race?
 #include <thread>
 
 #include "aoc.h"
+#include "aocinput.h"
+#include "aoclog.h"
+#include "aocparse.h"
 
 
 struct race {
@@ -147,7 +151,10 @@ struct race {
 
 	long travel(long press) const {
 		if (press < time) {
-			return (time - press) * press;
+			long distance;
+			// Farther than any record when it does not fit in a long.
+			if (__builtin_mul_overflow(time - press, press, &distance)) return __LONG_MAX__;
+			return distance;
 		}
 		return 0;
 	}
@@ -156,26 +163,31 @@ struct race {
 };
 
 
-long day06(int puzzle_part, std::istream& puzzle_input)
+// Parsed puzzle input: races for both parts.
+struct day06_input : parsed_input {
+	std::vector<race> races;		// Part 1: several races.
+	std::vector<race> kerning;		// Part 2: only one race, ignoring the spaces.
+};
+
+// Reads the race data from puzzle input.
+std::unique_ptr<day06_input> readraces(std::istream& puzzle_input)
 {
-	long margin = 1;	// Solution is stored here.
+	auto parsed = std::make_unique<day06_input>();
 
 	// Read puzzle input into two strings.
 	std::string times;
 	std::string distances;
 	std::getline(puzzle_input, times);
 	std::getline(puzzle_input, distances);
-	if (debug) {
-		std::cout << "Line 1: " << times << std::endl;
-		std::cout << "Line 2: " << distances << std::endl;
+	if (log_debug()) {
+		log_line() << "Line 1: " << times;
+		log_line() << "Line 2: " << distances;
 	}
 	
-	// Parse race data.
-	std::vector<race> races;
-	size_t t_pos = times.find(':') + 1;
-	size_t d_pos = distances.find(':') + 1;
-
-	if (1 == puzzle_part) {
+	// Parse race data for part 1.
+	{
+		size_t t_pos = times.find(':') + 1;
+		size_t d_pos = distances.find(':') + 1;
 		bool active = true;
 		while (active) {
 			t_pos = times.find_first_not_of(' ', t_pos);
@@ -183,17 +195,22 @@ long day06(int puzzle_part, std::istream& puzzle_input)
 			auto t_len = times.find_first_of(' ', t_pos) - t_pos;
 			auto d_len = distances.find_first_of(' ', d_pos) - d_pos;
 			
-			if (debug) std::cout << "T " << times.substr(t_pos, t_len) << " D " << distances.substr(d_pos, d_len) << std::endl;
+			if (log_debug()) log_line() << "T " << times.substr(t_pos, t_len) << " D " << distances.substr(d_pos, d_len);
 
-			races.push_back({
-				std::stol(times.substr(t_pos, t_len)),
-				std::stol(distances.substr(d_pos, d_len))
+			parsed->races.push_back({
+				to_number(std::string_view(times).substr(t_pos, t_len)),
+				to_number(std::string_view(distances).substr(d_pos, d_len))
 			});
 			t_pos += t_len;
 			d_pos += d_len;
 			if ((t_pos >= times.length()) || (d_pos >= distances.length())) active = false;
 		}
-	} else {
+	}
+
+	// Parse race data for part 2.
+	{
+		size_t t_pos = times.find(':') + 1;
+		size_t d_pos = distances.find(':') + 1;
 		std::string timestr;
 		while (t_pos < times.length()) {
 			if (isdigit(times.at(t_pos))) {
@@ -209,26 +226,75 @@ long day06(int puzzle_part, std::istream& puzzle_input)
 			d_pos += 1;
 		}
 
-		races.push_back({std::stol(timestr), std::stol(distancestr)});
+		parsed->kerning.push_back({to_number(timestr), to_number(distancestr)});
 	}
 
-	if (debug) std::cout << "Races: " << races.size() << std::endl;
-	for (const auto& race : races) {
-		long beats = 0;
+	return parsed;
+}
 
-		if (debug) std::cout << "Time: " << race.time << " Distance: " << race.distance << std::endl;
-		for (auto i = 1; i < race.time; ++i) {
-			auto t = race.travel(i);
-			//if (debug) std::cout << "Press: " << i << " Travel: " << t << std::endl;
-			if (t > race.distance) beats += 1;
-		}
+// Number of ways to beat the record, trying every press.
+long loopbeats(const race& race)
+{
+	long beats = 0;
+	for (long i = 1; i < race.time; ++i) {
+		auto t = race.travel(i);
+		//if (log_debug()) log_line() << "Press: " << i << " Travel: " << t;
+		if (t > race.distance) beats += 1;
+	}
+	return beats;
+}
+
+// Number of ways to beat the record, from the roots of
+// press * (time - press) = distance.  The presses in between beat the
+// record.  The roots are rounded outwards and then moved in with exact
+// integer checks, so floating point errors do not matter.
+long rootbeats(const race& race)
+{
+	long double discriminant = static_cast<long double>(race.time) * race.time - 4.0L * race.distance;
+	if (discriminant < 0) return 0;
+	long double root = std::sqrt(discriminant);
+	long low = std::max(1L, static_cast<long>(std::floor((race.time - root) / 2)) - 1);
+	long high = std::min(race.time - 1, static_cast<long>(std::ceil((race.time + root) / 2)) + 1);
+	while ((low <= high) && (race.travel(low) <= race.distance)) ++low;
+	while ((high >= low) && (race.travel(high) <= race.distance)) --high;
+	return high - low + 1;
+}
+
+// Multiply together the number of ways to beat the record in each race.
+long margin(const std::vector<race>& races, long (*beats)(const race&) = rootbeats)
+{
+	long margin = 1;	// Solution is stored here.
 
-		margin *= beats;
+	if (log_debug()) log_line() << "Races: " << races.size();
+	for (const auto& race : races) {
+		if (log_debug()) log_line() << "Time: " << race.time << " Distance: " << race.distance;
+		margin *= beats(race);
 	}
 
 	return margin;
 }
 
+long day06(int puzzle_part, std::istream& puzzle_input)
+{
+	auto parsed = readraces(puzzle_input);
+	return margin((1 == puzzle_part) ? parsed->races : parsed->kerning);
+}
+
+
+std::unique_ptr<parsed_input> day06_parse(std::string_view puzzle_input)
+{
+	membuf buf(puzzle_input);
+	std::istream is(&buf);
+	return readraces(is);
+}
+
+long day06_part1(const parsed_input& input) { return margin(static_cast<const day06_input&>(input).races); }
+long day06_part2(const parsed_input& input) { return margin(static_cast<const day06_input&>(input).kerning); }
+
+// Loop engine, the reference for the closed form above.
+long day06_loop_part1(const parsed_input& input) { return margin(static_cast<const day06_input&>(input).races, loopbeats); }
+long day06_loop_part2(const parsed_input& input) { return margin(static_cast<const day06_input&>(input).kerning, loopbeats); }
+
 /*
 Urgh, this was a parsing problem again. Not fun at all.
 
@@ -145,11 +145,16 @@ are the new total winnings?
 #include <algorithm>
 #include <functional>
 #include <array>
+#include <map>
 #include <set>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cctype>
 #include <cmath>
@@ -157,70 +162,85 @@ are the new total winnings?
 #include <cassert>
 
 #include "aoc.h"
-
-// Global flag: Is J card joker or not?
-bool jokers_enabled = false;
-
-// Card is stored in this data structure.
-struct card {
-	int value = 0;	// Instead of the card label, its value is stored.
-
+#include "aocarena.h"
+#include "aocinput.h"
+#include "aoclog.h"
+#include "aocparse.h"
+#include "aocserial.h"
+#include "aoctrace.h"
+
+// Hand and bid as read from the puzzle input, packed into 64 bits: the cards
+// in the highest 20 bits, four bits for each from the first card, and the
+// bid in the rest.  A card is the position of its label in
+// card_labels::labels plus one, or zero for an unknown label.  Card values
+// depend on the puzzle part, so they are decided only when solving.
+using play = uint64_t;
+constexpr int bid_bits = 44;
+constexpr play bid_mask = (play(1) << bid_bits) - 1;
+
+// Card label tables, shared by the cards of both parts.
+struct card_labels {
 	// Tables for converting card value back to label.
 	static const char labels[13];
 	static const char joker_labels[13];
+};
 
-	// Implicit constructor creates an empty card, this
-	// method sets the card value.
-	void set(const char c) {
-		if (false == jokers_enabled) {
-			for (int i = 0; i < 13; ++i) {
-				if (c == labels[i]) { value = i + 1; break; }
-			}
-		} else {
-			for (int i = 0; i < 13; ++i) {
-				if (c == joker_labels[i]) { value = i + 1; break; }
-			}
-		}
+// Card is stored in this data structure.  Whether J card is joker or
+// not is a template parameter, so each part has card code of its own
+// without checking it for every card.
+template <bool jokers_enabled>
+struct card : card_labels {
+	int value = 0;	// Instead of the card label, its value is stored.
+
+	// Label table of this part.
+	static constexpr const char* table() { return jokers_enabled ? joker_labels : labels; }
+
+	// Implicit constructor creates an empty card, this method sets the card
+	// value from its position in card_labels::labels plus one.  Card values
+	// depend on whether J card is joker or not.
+	void set_code(int code) {
+		if constexpr (jokers_enabled) value = (10 == code) ? 1 : ((code > 0) && (code < 10)) ? code + 1 : code;
+		else value = code;
 	}
 
 	// Return card label.
 	char label() const {
-		if (false == jokers_enabled) {
-			return (value > 0) ? labels[value - 1] : 0;
-		} else {
-			return (value > 0) ? joker_labels[value - 1] : 0;
-		}
+		return (value > 0) ? table()[value - 1] : 0;
 	}
 
 	// Card is joker if jokers are enabled and it's the 'J' card.
-	inline bool is_joker() const { return jokers_enabled ? (1 == value) : false; }
+	inline bool is_joker() const {
+		if constexpr (jokers_enabled) return 1 == value;
+		else return false;
+	}
 
 	friend inline bool operator==(card lhs, card rhs) { return lhs.value == rhs.value; }
 	friend inline bool operator< (card lhs, card rhs) { return lhs.value < rhs.value; }
 };
 
 // Card label tables.
-const char card::labels[13] = {	'2', '3', '4', '5', '6', '7', '8', '9',	'T', 'J', 'Q', 'K', 'A' };
-const char card::joker_labels[13] = { 'J', '2', '3', '4', '5', '6', '7', '8', '9', 'T', 'Q', 'K', 'A' };
+const char card_labels::labels[13] = {	'2', '3', '4', '5', '6', '7', '8', '9',	'T', 'J', 'Q', 'K', 'A' };
+const char card_labels::joker_labels[13] = { 'J', '2', '3', '4', '5', '6', '7', '8', '9', 'T', 'Q', 'K', 'A' };
 
 
 // The card hand is stored in this data structure.
+// J cards are jokers or not by the template parameter.
+template <bool jokers_enabled>
 struct hand {
 	// Both arrays contain same cards.
-	card sorted_cards[5] { 0, 0, 0, 0, 0 };	// Card sorted by value.
-	card inhand_cards[5] { 0, 0, 0, 0, 0 };	// Here we have the cards in original order.
+	card<jokers_enabled> sorted_cards[5] {};	// Card sorted by value.
+	card<jokers_enabled> inhand_cards[5] {};	// Here we have the cards in original order.
 	long bid;
 
 	// Implicit constructor creates an empty hand, this
-	// method sets the cards into hand.
-	void set(std::string s, long b) {
+	// method sets the cards and bid of a play into hand.
+	void set(play p) {
 		for (int i = 0; i < 5; ++i) {
-			char c = s[i];
-			inhand_cards[i].set(c);
-			sorted_cards[i].set(c);
+			inhand_cards[i].set_code((p >> (bid_bits + 4 * (4 - i))) & 15);
+			sorted_cards[i] = inhand_cards[i];
 		}
 		std::sort(sorted_cards, sorted_cards+5);
-		bid = b;
+		bid = p & bid_mask;
 	}
 
 	// Return hand as card label string.
@@ -294,6 +314,14 @@ struct hand {
 		return 1;					// high card
 	}
 
+	// Return a number that orders hands the same way as betterhand():
+	// hand rank first, then the card values in original order.
+	long strength() const {
+		long s = value();
+		for (const auto& c : inhand_cards) s = (s << 4) | c.value;
+		return s;
+	}
+
 	// Return string of hand rank value.
 	std::string valuestring() const {
 		switch (value()) {
@@ -313,7 +341,8 @@ struct hand {
 // Evaluation function for sort().
 // Hand has lower value when the hand rank (hand.value) is lower,
 // or if the rank is equal, when non-sorted card values are lower.
-bool betterhand(const hand& lhs, const hand& rhs) {
+template <bool jokers_enabled>
+bool betterhand(const hand<jokers_enabled>& lhs, const hand<jokers_enabled>& rhs) {
 	if (lhs.value() == rhs.value()) {
 		// Same rank, compare card values.
 		for (int i = 0; i < 5; ++i) {
@@ -328,45 +357,154 @@ bool betterhand(const hand& lhs, const hand& rhs) {
 }
 
 
-long day07(int puzzle_part, std::istream& puzzle_input)
+// Cards of a hand packed as in a play.
+uint32_t cardcode(std::string_view cards)
+{
+	uint32_t code = 0;
+	for (int i = 0; i < 5; ++i) {
+		auto label = std::find(card_labels::labels, card_labels::labels + 13, (i < static_cast<int>(cards.size())) ? cards[i] : 0);
+		code = (code << 4) | ((label != card_labels::labels + 13) ? (label - card_labels::labels + 1) : 0);
+	}
+	return code;
+}
+
+// Given one line of puzzle input, return the hand and bid.
+play readplay(std::string_view line)
+{
+	auto pos = line.find(' ');
+	long bid = to_number(line.substr(pos + 1));
+	if ((bid < 0) || (bid > static_cast<long>(bid_mask))) throw "Bid out of range";
+	return (play(cardcode(line.substr(0, pos))) << bid_bits) | bid;
+}
+
+// Total winnings of the hands.  J cards are jokers in puzzle part 2.
+template <bool jokers_enabled>
+long winnings(std::span<const play> plays)
 {
 	long total = 0;	// Solution result is stored here.
 
-	// Set the global flag when running puzzle part 2.
-	jokers_enabled = (puzzle_part == 2) ? true : false;
-	if (debug) std::cout << "\nUsing joker cards: " << (jokers_enabled ? "YES" : "NO") << std::endl;
+	if (log_debug()) log_line() << "\nUsing joker cards: " << (jokers_enabled ? "YES" : "NO");
 	
-	std::vector<hand> hands;	// All card hands are stored here.
-
-	// Read puzzle input
-	for (std::string line; std::getline(puzzle_input, line); ) {
-		auto pos = line.find(' ');
-		hand h;
-		h.set(line.substr(0, pos), std::stol(line.substr(pos + 1)));
+	std::vector<hand<jokers_enabled>> hands;	// All card hands are stored here.
+	hands.reserve(plays.size());
+	for (auto p : plays) {
+		hand<jokers_enabled> h;
+		h.set(p);
 		hands.push_back(h);
 	}
 
-	if (debug) {
+	if (log_trace()) {
 		for (const auto& h : hands) {
-			std::cout << "Hand: " << h.cardstring() << " Diff cards: " << h.num_diff()
-				<< " Most same: " << h.most_same() << " Bid: " << h.bid << std::endl;
+			log_line() << "Hand: " << h.cardstring() << " Diff cards: " << h.num_diff()
+				<< " Most same: " << h.most_same() << " Bid: " << h.bid;
 		}
 	}
 
-	// Sort hands.
-	if (debug) std::cout << "Sorting " << hands.size() << " items." << std::endl;
-	std::sort(hands.begin(), hands.end(), betterhand);
+	// Sort hands.  Equal hands keep their input order, ranked like groupedwinnings() does.
+	if (log_debug()) log_line() << "Sorting " << hands.size() << " items.";
+	{
+		trace_span span("day07 sort");
+		std::stable_sort(hands.begin(), hands.end(), betterhand<jokers_enabled>);
+	}
 
 	// Count each hand totals.
 	long rank = 1;
 	for (const auto& h : hands) {
-		if (debug) std::cout << "# " << rank << ": " << h.cardstring() << " " << h.valuestring() << std::endl;
+		if (log_trace()) log_line() << "# " << rank << ": " << h.cardstring() << " " << h.valuestring();
 		total += h.bid * rank++;
 	}
 
 	return total;
 }
 
+
+// Hands of the same strength, grouped while streaming the puzzle input.
+struct handgroup {
+	long count = 0;			// Number of hands.
+	long bids = 0;			// Sum of their bids.
+	long ranked_bids = 0;	// Sum of bid × order of arrival within the group.
+};
+
+// Reads the hands one line at a time and groups them by strength instead of
+// storing and sorting them, so memory use is bounded by the number of
+// different hands, not by the input size.  Hands in a group are ranked in
+// the order they were read.
+template <bool jokers_enabled>
+long groupedwinnings(std::istream& puzzle_input)
+{
+	std::map<long, handgroup> groups;
+	for (std::string line; std::getline(puzzle_input, line); ) {
+		hand<jokers_enabled> h;
+		h.set(readplay(line));
+		auto& g = groups[h.strength()];
+		g.count += 1;
+		g.bids += h.bid;
+		g.ranked_bids += g.count * h.bid;
+	}
+
+	// Group ranks follow each other in strength order.
+	long total = 0;
+	long rank = 0;	// Rank of the last hand of the previous group.
+	for (const auto& [strength, g] : groups) {
+		total += rank * g.bids + g.ranked_bids;
+		rank += g.count;
+	}
+
+	return total;
+}
+
+
+long day07(int puzzle_part, std::istream& puzzle_input)
+{
+	return (2 == puzzle_part) ? groupedwinnings<true>(puzzle_input) : groupedwinnings<false>(puzzle_input);
+}
+
+
+// Parsed puzzle input: hands and bids, solved in place from a binary input.
+struct day07_input : parsed_input {
+	std::span<const play> plays;
+	std::pmr::vector<play> parsed_plays { day_resource() };
+};
+
+// Binary input: the plays as they are.
+void day07_save(const parsed_input& input, std::string& out)
+{
+	const auto& parsed = static_cast<const day07_input&>(input);
+	serial_writer w(out);
+	w.put_all(parsed.plays);
+}
+
+std::unique_ptr<parsed_input> day07_load(std::string_view data)
+{
+	auto parsed = std::make_unique<day07_input>();
+	serial_reader r(data);
+	r.get_span(parsed->plays);
+	if (!r.at_end()) return nullptr;
+	// Every card is a known label or none.
+	for (auto p : parsed->plays) {
+		for (int i = 0; i < 5; ++i) {
+			if (((p >> (bid_bits + 4 * i)) & 15) > 13) return nullptr;
+		}
+	}
+	return parsed;
+}
+
+std::unique_ptr<parsed_input> day07_parse(std::string_view puzzle_input)
+{
+	std::string_view payload;
+	if (binary_payload(puzzle_input, 7, payload)) return valid_binary(day07_load(payload));
+
+	auto parsed = std::make_unique<day07_input>();
+	for (auto line : lines(puzzle_input)) {
+		parsed->parsed_plays.push_back(readplay(line));
+	}
+	parsed->plays = parsed->parsed_plays;
+	return parsed;
+}
+
+long day07_part1(const parsed_input& input) { return winnings<false>(static_cast<const day07_input&>(input).plays); }
+long day07_part2(const parsed_input& input) { return winnings<true>(static_cast<const day07_input&>(input).plays); }
+
 /*
 
 */
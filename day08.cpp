@@ -115,10 +115,12 @@ it take before you're only on nodes that end with Z?
 #include <array>
 #include <set>
 #include <deque>
+#include <memory>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cctype>
 #include <cmath>
@@ -126,6 +128,8 @@ it take before you're only on nodes that end with Z?
 #include <cassert>
 
 #include "aoc.h"
+#include "aocinput.h"
+#include "aoclog.h"
 
 
 // Single node is stored in this data structure.
@@ -177,18 +181,23 @@ struct instruction {
 };
 
 
-long day08(int puzzle_part, std::istream& puzzle_input)
-{
-	long total = 0;	// Solution result is stored here.
-
+// Parsed puzzle input: route and the network of instructions.
+struct day08_input : parsed_input {
+	std::string route;
 	// The instructions read from puzzle input.
 	// Node value is the key.
 	std::map<long, instruction>	instructions;
+};
+
+// Read route and instructions from puzzle input.
+void readmaps(day08_input& maps, std::istream& puzzle_input)
+{
+	auto& route = maps.route;
+	auto& instructions = maps.instructions;
 
 	// Read puzzle input, first route string.
-	std::string route;
 	std::getline(puzzle_input, route);
-	if (debug) std::cout << "Route: " << route << std::endl;
+	if (log_debug()) log_line() << "Route: " << route;
 
 	// Read puzzle input, instruction strings.
 	for (std::string line; std::getline(puzzle_input, line); ) {
@@ -197,14 +206,13 @@ long day08(int puzzle_part, std::istream& puzzle_input)
 		instructions.insert({inst.tgt.n, inst});
 	}
 
-	if (debug) {
-		std::cout << "Instructions count: " << instructions.size() << std::endl;
+	if (log_debug()) log_line() << "Instructions count: " << instructions.size();
+	if (log_trace()) {
 		for (const auto& i : instructions) {
-			std::cout << "Idx: " << i.first
+			log_line() << "Idx: " << i.first
 				<< "\tTgt: " << i.second.tgt.name() << " (" << i.second.tgt.n << ")"
 				<< "\tLeft: " << i.second.left.name() << " (" << i.second.left.n << ")"
-				<< "\tRight: " << i.second.right.name() << " (" << i.second.right.n << ")"
-				<< std::endl;
+				<< "\tRight: " << i.second.right.name() << " (" << i.second.right.n << ")";
 		}
 	}
 
@@ -213,15 +221,25 @@ long day08(int puzzle_part, std::istream& puzzle_input)
 		i_it->second.ileft = &instructions.at(i_it->second.left.n);
 		i_it->second.iright = &instructions.at(i_it->second.right.n);
 	}
+}
+
+
+// Count the hops needed to reach the end node(s).
+long routehops(int puzzle_part, const day08_input& maps)
+{
+	long total = 0;	// Solution result is stored here.
+
+	const auto& route = maps.route;
+	const auto& instructions = maps.instructions;
 
 	if (1 == puzzle_part) {
 		auto r = route.begin();
 
 		// Count the route hops, start from "AAA" node.
-		instruction* curr = &instructions.at(node("AAA").n);
+		const instruction* curr = &instructions.at(node("AAA").n);
 		while (!curr->is_zzz) {
-			if (debug) std::cout << "Node: " << curr->tgt.name()
-				<< (('R' == *r) ? std::string(" R: " + curr->iright->tgt.name()) : std::string(" L: " + curr->ileft->tgt.name())) << std::endl;
+			if (log_trace()) log_line() << "Node: " << curr->tgt.name()
+				<< (('R' == *r) ? std::string(" R: " + curr->iright->tgt.name()) : std::string(" L: " + curr->ileft->tgt.name()));
 
 			curr = ('R' == *r) ? curr->iright : curr->ileft;	// Follow the route.
 			if (++r == route.end()) r = route.begin();	// Repeat route if exhausted.
@@ -232,9 +250,9 @@ long day08(int puzzle_part, std::istream& puzzle_input)
 
 		// Collect starting nodes.
 		std::vector<node> starts;
-		for (auto i : instructions) {
+		for (const auto& i : instructions) {
 			if (i.second.tgt.ends_with('A')) {
-				if (debug) std::cout << "Starting point: " << i.second.tgt.name() << std::endl;
+				if (log_debug()) log_line() << "Starting point: " << i.second.tgt.name();
 				starts.push_back(i.second.tgt);
 			}
 		}
@@ -244,27 +262,48 @@ long day08(int puzzle_part, std::istream& puzzle_input)
 		total = 1;
 		for (auto sp : starts) {
 			long hops = 0;
-			instruction* curr = &instructions.at(sp.n);
+			const instruction* curr = &instructions.at(sp.n);
 			while (!curr->ends_in_z) {
-				if (debug) std::cout << "Node: " << curr->tgt.name()
-					<< (('R' == *r) ? std::string(" R: " + curr->iright->tgt.name()) : std::string(" L: " + curr->ileft->tgt.name())) << std::endl;
+				if (log_trace()) log_line() << "Node: " << curr->tgt.name()
+					<< (('R' == *r) ? std::string(" R: " + curr->iright->tgt.name()) : std::string(" L: " + curr->ileft->tgt.name()));
 				curr = ('R' == *r) ? curr->iright : curr->ileft;
 				if (++r == route.end()) {
 					r = route.begin();
 				}
 				hops += 1;
 			}
-			if (debug) std::cout << "Hops: " << hops << std::endl;
+			if (log_debug()) log_line() << "Hops: " << hops;
 			total = std::lcm(total, hops);
 		}
 	}
 
-	if (debug) std::cout << "End found after hop: " << total << std::endl;
+	if (log_debug()) log_line() << "End found after hop: " << total;
 
 	return total;
 }
 
 
+long day08(int puzzle_part, std::istream& puzzle_input)
+{
+	day08_input maps;
+	readmaps(maps, puzzle_input);
+	return routehops(puzzle_part, maps);
+}
+
+
+std::unique_ptr<parsed_input> day08_parse(std::string_view puzzle_input)
+{
+	auto parsed = std::make_unique<day08_input>();
+	membuf buf(puzzle_input);
+	std::istream is(&buf);
+	readmaps(*parsed, is);
+	return parsed;
+}
+
+long day08_part1(const parsed_input& input) { return routehops(1, static_cast<const day08_input&>(input)); }
+long day08_part2(const parsed_input& input) { return routehops(2, static_cast<const day08_input&>(input)); }
+
+
 /*
 First puzzle this year where brute force looping isn't practical.
 Part 1 is easy, but part 2 needs to be split into separate routes
@@ -152,11 +152,15 @@ value for each history. What is the sum of these extrapolated values?
 #include <numeric>
 #include <array>
 #include <set>
+#include <span>
 #include <deque>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cctype>
 #include <cmath>
@@ -164,10 +168,17 @@ value for each history. What is the sum of these extrapolated values?
 #include <cassert>
 
 #include "aoc.h"
+#include "aocarena.h"
+#include "aocinput.h"
+#include "aoclog.h"
+#include "aocparse.h"
+#include "aocserial.h"
 
 
-long sequence(std::vector<long>& seq) {
-	std::vector<long> diffs;
+// Differences of all levels are allocated from 'scratch', freed by the caller.
+long sequence(std::span<const long> seq, std::pmr::memory_resource* scratch) {
+	std::pmr::vector<long> diffs(scratch);
+	diffs.reserve(seq.size());
 	bool all_zeroes = true;
 	auto seq_it = seq.begin();
 	long prev = *seq_it;
@@ -178,16 +189,17 @@ long sequence(std::vector<long>& seq) {
 		prev = *seq_it;
 	}
 	if (all_zeroes == false) {
-		auto a = sequence(diffs);
+		auto a = sequence(diffs, scratch);
 		diffs.push_back(diffs.back() + a);
 	}
-	if (debug) { std::cout << "Seq: "; print_vec(diffs); std::cout << std::endl; }
+	if (log_trace()) { log_line line; line << "Seq: "; print_vec(diffs, line); }
 	return diffs.back();
 }
 
 
-long revsequence(std::vector<long>& seq) {
-	std::vector<long> diffs;
+long revsequence(std::span<const long> seq, std::pmr::memory_resource* scratch) {
+	std::pmr::vector<long> diffs(scratch);
+	diffs.reserve(seq.size());
 	bool all_zeroes = true;
 	auto seq_it = seq.rbegin();
 	long prev = *seq_it;
@@ -198,67 +210,150 @@ long revsequence(std::vector<long>& seq) {
 		prev = *seq_it;
 	}
 	if (all_zeroes == false) {
-		auto a = revsequence(diffs);
+		auto a = revsequence(diffs, scratch);
 		diffs.insert(diffs.begin(), diffs.front() - a);
 	}
-	if (debug) { std::cout << "Seq: "; print_vec(diffs); std::cout << std::endl; }
+	if (log_trace()) { log_line line; line << "Seq: "; print_vec(diffs, line); }
 	return diffs.front();
 }
 
 
-long extrapolate(std::vector<long>& seq) {
-	auto a = sequence(seq);
-	seq.push_back(seq.back() + a);
-	if (debug) { std::cout << "Seq: "; print_vec(seq); std::cout << std::endl; }
-	return seq.back();
+// Scratch memory for the differences of one sequence, on the stack.
+// Longer sequences continue in the day resource.
+constexpr size_t scratch_size = 8192;
+
+long extrapolate(std::span<const long> seq) {
+	std::array<std::byte, scratch_size> buffer;
+	std::pmr::monotonic_buffer_resource scratch(buffer.data(), buffer.size(), day_resource());
+	auto a = sequence(seq, &scratch);
+	if (log_trace()) { log_line line; line << "Seq: "; print_vec(seq, line); line << seq.back() + a; }
+	return seq.back() + a;
 }
 
 
-long revextrapolate(std::vector<long>& seq) {
-	auto a = revsequence(seq);
-	seq.insert(seq.begin(), seq.front() - a);
-	if (debug) { std::cout << "Seq: "; print_vec(seq); std::cout << std::endl; }
-	return seq.front();
+long revextrapolate(std::span<const long> seq) {
+	std::array<std::byte, scratch_size> buffer;
+	std::pmr::monotonic_buffer_resource scratch(buffer.data(), buffer.size(), day_resource());
+	auto a = revsequence(seq, &scratch);
+	if (log_trace()) { log_line line; line << "Seq: " << seq.front() - a << " "; print_vec(seq, line); }
+	return seq.front() - a;
 }
 
 
-long day09(int puzzle_part, std::istream& puzzle_input)
+// Given one line of puzzle input, return the sensor readings.
+std::pmr::vector<long> readings(std::string_view line)
 {
-	long total = 0;	// Solution result is stored here.
-
-	// Sensor readings from puzzle input.
-	std::vector<std::vector<long>> sensor_readings;
-
-	// Read puzzle input.
-	for (std::string line; std::getline(puzzle_input, line); ) {
-		std::vector<long> readings;
-		auto ss = std::stringstream(line);
-		for (std::string s; std::getline(ss, s, ' '); ) {
-			readings.push_back(std::stol(s));
-		}
-		if (debug) { for (const auto& r : readings) std::cout << r << " "; std::cout << std::endl; }
-		sensor_readings.push_back(readings);
-	}
+	std::pmr::vector<long> readings(day_resource());
+	parse_numbers(line, readings);
+	if (log_trace()) { log_line line; print_vec(readings, line); }
+	return readings;
+}
 
-	if (debug) std::cout << "Number of lines: " << sensor_readings.size() << std::endl;
+// Parsed puzzle input: the sensor readings of all lines one after another,
+// and the offset where each line starts, followed by the end of the last.
+// Readings of binary input are used in place, text input is parsed into
+// the vectors.
+struct day09_input : parsed_input {
+	std::span<const long> values;
+	std::span<const long> offsets;
+	std::pmr::vector<long> parsed_values { day_resource() };
+	std::pmr::vector<long> parsed_offsets { day_resource() };
+
+	size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+	std::span<const long> line(size_t i) const { return values.subspan(offsets[i], offsets[i + 1] - offsets[i]); }
+};
+
+// Solve the puzzle for the sensor readings read from puzzle input.
+long oasis(int puzzle_part, const day09_input& sensor_readings)
+{
+	long total = 0;	// Solution result is stored here.
 
+	if (log_debug()) log_line() << "Number of lines: " << sensor_readings.size();
 	if (1 == puzzle_part) {
-		for (auto& sr : sensor_readings) {
-			if (debug) { std::cout << "Extrapolating: "; print_vec(sr); std::cout << std::endl; }
+		for (size_t i = 0; i < sensor_readings.size(); ++i) {
+			auto sr = sensor_readings.line(i);
+			if (log_trace()) { log_line line; line << "Extrapolating: "; print_vec(sr, line); }
 			total += extrapolate(sr);
 		}
 	} else {
-		for (auto& sr : sensor_readings) {
-			if (debug) { std::cout << "Reverse extrapolating: "; print_vec(sr); std::cout << std::endl; }
+		for (size_t i = 0; i < sensor_readings.size(); ++i) {
+			auto sr = sensor_readings.line(i);
+			if (log_trace()) { log_line line; line << "Reverse extrapolating: "; print_vec(sr, line); }
 			total += revextrapolate(sr);
 		}
 	}
 
-	if (debug) std::cout << "Total: " << total << std::endl;
+	if (log_debug()) log_line() << "Total: " << total;
+	return total;
+}
+
+
+// Reads and extrapolates the sensor readings one line at a time.
+long day09(int puzzle_part, std::istream& puzzle_input)
+{
+	long total = 0;	// Solution result is stored here.
+
+	for (std::string line; std::getline(puzzle_input, line); ) {
+		auto sr = readings(line);
+		if (sr.empty()) continue;
+		total += (1 == puzzle_part) ? extrapolate(sr) : revextrapolate(sr);
+	}
 
 	return total;
 }
 
 
+// Binary input: the line offsets and the readings, in place.
+std::unique_ptr<parsed_input> day09_load(std::string_view data)
+{
+	auto parsed = std::make_unique<day09_input>();
+	serial_reader r(data);
+	r.get_span(parsed->offsets);
+	r.get_span(parsed->values);
+	if (!r.at_end()) return nullptr;
+	// Offsets start from the first reading and end after the last one, and
+	// every line has at least one reading, as the extrapolation needs one.
+	const auto& offsets = parsed->offsets;
+	if (offsets.empty() || (0 != offsets.front()) || (offsets.back() != static_cast<long>(parsed->values.size()))) return nullptr;
+	for (size_t i = 1; i < offsets.size(); ++i) {
+		if (offsets[i] <= offsets[i - 1]) return nullptr;
+	}
+	return parsed;
+}
+
+void day09_save(const parsed_input& input, std::string& out)
+{
+	const auto& parsed = static_cast<const day09_input&>(input);
+	serial_writer w(out);
+	w.put_all(parsed.offsets);
+	w.put_all(parsed.values);
+}
+
+std::unique_ptr<parsed_input> day09_parse(std::string_view puzzle_input)
+{
+	std::string_view payload;
+	if (binary_payload(puzzle_input, 9, payload)) return valid_binary(day09_load(payload));
+
+	auto parsed = std::make_unique<day09_input>();
+	// Read puzzle input, without copying.
+	for (auto line : lines(puzzle_input)) {
+		parsed->parsed_offsets.push_back(parsed->parsed_values.size());
+		parse_numbers(line, parsed->parsed_values);
+		if (parsed->parsed_offsets.back() == static_cast<long>(parsed->parsed_values.size())) {
+			parsed->parsed_offsets.pop_back();	// No readings on the line.
+			continue;
+		}
+		if (log_trace()) { log_line line; print_vec(std::span<const long>(parsed->parsed_values).subspan(parsed->parsed_offsets.back()), line); }
+	}
+	parsed->parsed_offsets.push_back(parsed->parsed_values.size());
+	parsed->values = parsed->parsed_values;
+	parsed->offsets = parsed->parsed_offsets;
+	return parsed;
+}
+
+long day09_part1(const parsed_input& input) { return oasis(1, static_cast<const day09_input&>(input)); }
+long day09_part2(const parsed_input& input) { return oasis(2, static_cast<const day09_input&>(input)); }
+
+
 /*
 */
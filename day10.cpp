@@ -257,21 +257,27 @@ area within the loop. How many tiles are enclosed by the loop?
 #include <algorithm>
 #include <functional>
 #include <numeric>
-#include <bitset>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cctype>
 #include <cmath>
 
 #include <cassert>
 
-// Precessing graphics library.
-#include "p8g.hpp"
-
 #include "aoc.h"
+#include "aocarena.h"
+#include "aocgrid.h"
+#include "aocinput.h"
+#include "aoclog.h"
+#include "aoctrace.h"
+#include "aocvisual.h"
 
 
 // Coordinate location.
@@ -410,16 +416,6 @@ void move(dir d, coord& loc, const int n = 1) {
 }
 
 
-// Helper function to calculate x,y position in the array.
-inline size_t pipeat(coord loc, int max_x) { return loc.y * max_x + loc.x; }
-inline size_t pipeat(int x, int y, int max_x) { return y * max_x + x; }
-
-
-// Maximum size of the map.
-constexpr int	max_width = 140;
-constexpr int	max_height = 140;
-
-
 // Parameters for the solution parts.
 struct param_s {
 	int width = 0;		// Actual width of the puzzle input map.
@@ -428,118 +424,90 @@ struct param_s {
 	coord start { -1, -1 };		// Puzzle starting location.
 	coord end { -1, -1 };		// Puzzle end location.
 	coord bottom { -1, -1 };	// Most bottom location in pipeline.
-	
-	std::bitset<max_width * 3 * max_height * 3>	bitmap;
-	std::bitset<max_width * max_height> 		pipeline;
+
+	Grid<char> bitmap;		// Each tile as 3×3 pixels, set where the pipe is drawn.  Border is set too.
+	Grid<char> pipeline;	// Set for tiles that are part of the pipeline.
 };
-param_s* params = nullptr;		// Allocated in day10()
-maptile* tilemap = nullptr;		// Allocated in day10()
-
-
-// Callback methods for Precessing.
-void p8g::keyPressed() {}
-void p8g::keyReleased() {}
-void p8g::mouseMoved() {}
-void p8g::mousePressed() {}
-void p8g::mouseReleased() {}
-void p8g::mouseWheel(float delta) {}
-
-// Visualise the pipeline using Precessing.
-void p8g::draw() {
-	using namespace p8g;
-	background(18, 0, 31);
-	strokeWeight(params->scale);
-
-	stroke(255, 0, 0);	// Red box around.
-	fill(18, 0, 31);
-	rect(0, 0, width, height);
-
-	for (int y = 0; y < params->height; ++y) {
-		int offset = y * params->width;
-		for (int x = 0; x < params->width; ++x) {
-			// Choose drawing colour.
-			if (params->pipeline[offset + x]) {
-				if ((y == params->start.y) && (x == params->start.x)) {		// Pipeline start location
-					stroke(227, 121, 51);
-				} else if ((y == params->end.y) && (x == params->end.x)) {	// Pipeline end location
-					stroke(240, 33, 33);
-				} else if ((y == params->bottom.y) && (x == params->bottom.x)) {	// Most bottom location
-					stroke(26, 121, 241);
-				} else {	// Normal pipeline
-					stroke(78, 154, 36);
-				}
-			} else {
-				stroke(220, 220, 220);
-			}
-			// Draw subpixels.
-			for (int suby = y * 3; suby < y * 3 + 3; ++suby) {
-				int suboffset = suby * params->width * 3;
-				for (int subx = x * 3; subx < x * 3 + 3; ++subx) {
-					auto pix = params->bitmap[suboffset + subx];
-					if (pix) point(subx * params->scale + 1, suby * params->scale + 1);
-				}
-			}
-		}
-	}
-}
 
 
-// Recursive flood-fill paint function.
+// Flood-fill paint function.
 // Uses the 3× scaled 'bitmap' for painting and whenever a pixel is drawn, the corresponding
-// tile in 'tilemap' is marked as being 'enclosed'.
-// Does not check x or y boundaries as the pipeline will be bound to those limits anyway.
-void paint(coord p) {
-	if (params->bitmap[p.y * params->width * 3 + p.x]) return;	// Boundary hit.
-
-	params->bitmap[p.y * params->width * 3 + p.x] = true;
-	if (!tilemap[pipeat(p.x/3, p.y/3, params->width)].part_of_pipe) {
-		tilemap[pipeat(p.x/3, p.y/3, params->width)].enclosed = true;
+// tile in 'tilemap' is marked as being 'enclosed'.  The pixels to paint are kept on a
+// stack instead of recursing, as large maps would run out of call stack.
+// The border of the bitmap is set, so the paint cannot leak outside.
+void paint(param_s& params, Grid<maptile>& tilemap, coord p) {
+	std::pmr::vector<coord> stack(day_resource());
+	stack.push_back(p);
+	while (!stack.empty()) {
+		p = stack.back();
+		stack.pop_back();
+		if (params.bitmap(p.x, p.y)) continue;	// Boundary hit.
+
+		params.bitmap(p.x, p.y) = true;
+		auto& tile = tilemap(p.x / 3, p.y / 3);
+		if (!tile.part_of_pipe) tile.enclosed = true;
+
+		stack.push_back({ p.x - 1, p.y     });
+		stack.push_back({ p.x,     p.y - 1 });
+		stack.push_back({ p.x + 1, p.y     });
+		stack.push_back({ p.x,     p.y + 1 });
 	}
+}
+
 
-	paint({ p.x - 1, p.y     });
-	paint({ p.x,     p.y - 1 });
-	paint({ p.x + 1, p.y     });
-	paint({ p.x,     p.y + 1 });
+// Parsed puzzle input: the map tiles.  The border around the map is ground.
+struct day10_input : parsed_input {
+	coord start { -1, -1 };
+	Grid<maptile> tiles;
+};
+
+// Read map tiles from puzzle input.  Any size of map will do.
+void readtiles(day10_input& map, std::string_view puzzle_input)
+{
+	map.tiles = Grid<maptile>::load(puzzle_input, maptile());
+	for (int y = 0; y < map.tiles.height(); ++y) {
+		auto row = map.tiles.row(y);
+		auto s = std::find_if(row.begin(), row.end(), [](const maptile& t) { return t.is_start; });
+		if (s != row.end()) { map.start.x = std::distance(row.begin(), s); map.start.y = y; }
+	}
+	// The loop walk starts from the tiles around the start, which must be on the map.
+	if (map.start.x < 0) throw "No start location";
 }
 
 
-long day10(int puzzle_part, std::istream& puzzle_input)
+// Walk the pipeline loop, and for part 2 flood-fill the enclosed area.
+long pipeloop(int puzzle_part, const day10_input& map)
 {
 	long total = 0;	// Solution result is stored here.
 
-	// Allocate global data.
-	params = new param_s;
-	tilemap = new maptile[max_width * max_height];
-
-	// Read puzzle input.
-	{
-		maptile* pmp = tilemap;
-		for (std::string line; std::getline(puzzle_input, line); ) {
-			if (0 == params->width) params->width = line.length();
-			for (auto c = line.begin(); c != line.end(); ++c) {
-				*pmp++ = *c;
-				if ('S' == *c) { params->start.x = std::distance(line.begin(), c); params->start.y = params->height; }
-			}
-			params->height += 1;
-		}
-	}
+	// Puzzle data.  These are local so that several
+	// solutions can run concurrently from the same parsed map.
+	param_s params;
+	Grid<maptile> tilemap(map.tiles);
+
+	params.width = tilemap.width();
+	params.height = tilemap.height();
+	params.start = map.start;
+	params.bitmap = Grid<char>(params.width * 3, params.height * 3, false, true);
+	params.pipeline = Grid<char>(params.width, params.height, false, false);
 
 	if (true) {	// Part 1 and 2: Find the distance.
 		// Determine the shape of the start tile and then replace the tile with proper pipe shape.
-		int x = params->start.x;
-		int y = params->start.y;
+		// Tiles around the start are always there, the border is ground.
+		int x = params.start.x;
+		int y = params.start.y;
 		maptile start_tile;
-		if (tilemap[pipeat(x, y-1, params->width)].south && tilemap[pipeat(x, y+1, params->width)].north) start_tile = '|';
-		if (tilemap[pipeat(x-1, y, params->width)].east  && tilemap[pipeat(x, y-1, params->width)].south) start_tile = 'J';
-		if (tilemap[pipeat(x-1, y, params->width)].east  && tilemap[pipeat(x, y+1, params->width)].north) start_tile = '7';
-		if (tilemap[pipeat(x+1, y, params->width)].west  && tilemap[pipeat(x, y+1, params->width)].north) start_tile = 'F';
-		if (tilemap[pipeat(x+1, y, params->width)].west  && tilemap[pipeat(x, y-1, params->width)].south) start_tile = 'L';
-		if (tilemap[pipeat(x-1, y, params->width)].east  && tilemap[pipeat(x+1, y, params->width)].west)  start_tile = '-';
+		if (tilemap(x, y-1).south && tilemap(x, y+1).north) start_tile = '|';
+		if (tilemap(x-1, y).east  && tilemap(x, y-1).south) start_tile = 'J';
+		if (tilemap(x-1, y).east  && tilemap(x, y+1).north) start_tile = '7';
+		if (tilemap(x+1, y).west  && tilemap(x, y+1).north) start_tile = 'F';
+		if (tilemap(x+1, y).west  && tilemap(x, y-1).south) start_tile = 'L';
+		if (tilemap(x-1, y).east  && tilemap(x+1, y).west)  start_tile = '-';
 		start_tile.part_of_pipe = true;
 		start_tile.is_start = true;
-		tilemap[pipeat(params->start, params->width)] = start_tile;
+		tilemap(x, y) = start_tile;
 
-		if (debug) std::cout << "Start at: " << params->start.x << "," << params->start.y << ":" << tilemap[pipeat(params->start, params->width)].out() << std::endl;
+		if (log_debug()) log_line() << "Start at: " << params.start.x << "," << params.start.y << ":" << tilemap(x, y).out();
 
 		// Select directions to advance from the start tile.
 		dir direction1, direction2;
@@ -547,60 +515,63 @@ long day10(int puzzle_part, std::istream& puzzle_input)
 		direction2 = start_tile.picksecond(direction1);
 
 		// Move along the pipeline in two directions and stop when they end up in same location.
-		coord location1 = params->start;
-		coord location2 = params->start;
-		bool done = false;
-		while (!done) {
-			move(direction1, location1);
-			maptile& tile1 = tilemap[pipeat(location1, params->width)];
-			tile1.part_of_pipe = true;
-			direction1 = tile1.inout(direction1);
-
-			move(direction2, location2);
-			maptile& tile2 = tilemap[pipeat(location2, params->width)];
-			tile2.part_of_pipe = true;
-			direction2 = tile2.inout(direction2);
-
-			// Locate the bottom-most pipe section.
-			if (location2.y > params->bottom.y) { params->bottom = location2; }
-			if (location1.y > params->bottom.y) { params->bottom = location1; }
-
-			// Loop ends when both locations are the same.
-			if (location1 == location2) {
-				tile2.is_end = true;
-				done = true;
-			}
+		{
+			trace_span span("day10 loop walk");
+			coord location1 = params.start;
+			coord location2 = params.start;
+			bool done = false;
+			while (!done) {
+				move(direction1, location1);
+				maptile& tile1 = tilemap(location1.x, location1.y);
+				tile1.part_of_pipe = true;
+				direction1 = tile1.inout(direction1);
+
+				move(direction2, location2);
+				maptile& tile2 = tilemap(location2.x, location2.y);
+				tile2.part_of_pipe = true;
+				direction2 = tile2.inout(direction2);
+
+				// Locate the bottom-most pipe section.
+				if (location2.y > params.bottom.y) { params.bottom = location2; }
+				if (location1.y > params.bottom.y) { params.bottom = location1; }
+
+				// Loop ends when both locations are the same.
+				if (location1 == location2) {
+					tile2.is_end = true;
+					done = true;
+				}
 
-			total += 1;	// Count each step, it's the solution for part 1.
+				total += 1;	// Count each step, it's the solution for part 1.
+			}
 		}
 
-		// Make neat bitmap.  Each tile is drawn as 3×3 pixel element.
-		for (int y = 0; y < params->height; ++y) {
-			for (int x = 0; x < params->width; ++x) {
-				// draw() returns a vector of x,y values.
-				auto v = tilemap[pipeat(x, y, params->width)].draw();
-				// First item is the pixel/line properties.
-				auto v_it = v.begin();
-				if (v_it->x != 0) {
-					// Map tile is part of pipeline, so set that bit in the helper data.
-					params->pipeline[pipeat(x, y, params->width)] = true;
-				}
-				if (v_it->y > 0) {
-					// Map tile is the start location, store it.
-					params->start.x = x;
-					params->start.y = y;
-				} else if (v_it->y < 0) {
-					// Map tile is the end location, store it.
-					params->end.x = x;
-					params->end.y = y;
-				}
-				
-				// Draw pixels into the 3× bitmap, using the coordinates from the vector.
-				int fx = x * 3;
-				int fy = y * 3;
-				int fw = params->width * 3;
-				for (v_it++; v_it != v.end(); ++v_it) {
-					params->bitmap[pipeat(fx + v_it->x, fy + v_it->y, fw)] = true;
+		// Make neat bitmap for painting and visualisation.  Each tile is drawn as 3×3 pixel element.
+		{
+			trace_span span("day10 bitmap");
+			for (int y = 0; ((2 == puzzle_part) || debug) && (y < params.height); ++y) {
+				for (int x = 0; x < params.width; ++x) {
+					// draw() returns a vector of x,y values.
+					auto v = tilemap(x, y).draw();
+					// First item is the pixel/line properties.
+					auto v_it = v.begin();
+					if (v_it->x != 0) {
+						// Map tile is part of pipeline, so set that bit in the helper data.
+						params.pipeline(x, y) = true;
+					}
+					if (v_it->y > 0) {
+						// Map tile is the start location, store it.
+						params.start.x = x;
+						params.start.y = y;
+					} else if (v_it->y < 0) {
+						// Map tile is the end location, store it.
+						params.end.x = x;
+						params.end.y = y;
+					}
+
+					// Draw pixels into the 3× bitmap, using the coordinates from the vector.
+					for (v_it++; v_it != v.end(); ++v_it) {
+						params.bitmap(x * 3 + v_it->x, y * 3 + v_it->y) = true;
+					}
 				}
 			}
 		}
@@ -612,43 +583,60 @@ long day10(int puzzle_part, std::istream& puzzle_input)
 		// It can only be NW, NE, or EW tile, so y location is at the top and
 		// x location is easy to pick (left or right).
 		int xadj = 0;	// NW
-		if (tilemap[pipeat(params->bottom.x, params->bottom.y, params->width)].east) xadj = 2;	// NE or EW
-		paint({ params->bottom.x * 3 + xadj, params->bottom.y * 3 });
+		if (tilemap(params.bottom.x, params.bottom.y).east) xadj = 2;	// NE or EW
+		{
+			trace_span span("day10 flood fill");
+			paint(params, tilemap, { params.bottom.x * 3 + xadj, params.bottom.y * 3 });
+		}
 
 		// Count all map tiles that were marked as enclosed, that is the solution to part 2.
 		total = 0;
-		for (int i = 0; i < params->height * params->width; ++i) {
-			if (tilemap[i].enclosed) total += 1;
+		for (int y = 0; y < params.height; ++y) {
+			for (const auto& tile : tilemap.row(y)) {
+				if (tile.enclosed) total += 1;
+			}
 		}
 	}
-		
-	if (debug) {
+
+	if (log_debug()) {
 		// Output the pipe map to console.
-		for (int y = 0; y < params->height; ++y) {
-			for (int x = 0; x < params->width; ++x) {
-				std::cout << tilemap[y * params->width + x].out();
+		for (int y = 0; y < params.height; ++y) {
+			log_line line;
+			for (const auto& tile : tilemap.row(y)) {
+				line << tile.out();
 			}
-			std::cout << std::endl;
 		}
-		// Output the pipe map to Precessing window if X11 is active.
-		if (std::getenv("DISPLAY") != nullptr) {
-			p8g::run(max_width * 3 * params->scale + 2, max_height * 3 * params->scale + 2, "Day 10");
+		// Output the pipe map to Precessing window if X11 is active and the
+		// visualisation plugin loads, otherwise to console.
+		auto draw = (std::getenv("DISPLAY") != nullptr)
+			? reinterpret_cast<draw_pipeline_function*>(visual_function("aoc_draw_pipeline")) : nullptr;
+		if (nullptr != draw) {
+			pipeline_view view;
+			view.width = params.width;
+			view.height = params.height;
+			view.scale = params.scale;
+			view.start_x = params.start.x; view.start_y = params.start.y;
+			view.end_x = params.end.x; view.end_y = params.end.y;
+			view.bottom_x = params.bottom.x; view.bottom_y = params.bottom.y;
+			view.bitmap = &params.bitmap;
+			view.pipeline = &params.pipeline;
+			log_flush();	// The map above before the window.
+			draw(view);
 		} else {
-			for (int y = 0; y < params->height; ++y) {
-				int offset = y * params->width;
+			for (int y = 0; y < params.height; ++y) {
 				for (int suby = y * 3; suby < y * 3 + 3; ++suby) {
-					int suboffset = suby * params->width * 3;
-					for (int x = 0; x < params->width; ++x) {
+					log_line line;
+					for (int x = 0; x < params.width; ++x) {
 						char c = ' ';
 						std::string s;
-						if (tilemap[offset + x].part_of_pipe) {
-							if ((y == params->start.y) && (x == params->start.x)) {
+						if (tilemap(x, y).part_of_pipe) {
+							if ((y == params.start.y) && (x == params.start.x)) {
 								if (!unit_testing) s += "\e[33m";
 								c = '>';
-							} else if ((y == params->end.y) && (x == params->end.x)) {
+							} else if ((y == params.end.y) && (x == params.end.x)) {
 								if (!unit_testing) s += "\e[31m";
 								c = '<';
-							} else if ((y == params->bottom.y) && (x == params->bottom.x)) {
+							} else if ((y == params.bottom.y) && (x == params.bottom.x)) {
 								if (!unit_testing) s += "\e[34m";
 								c = '^';
 							} else {
@@ -657,33 +645,49 @@ long day10(int puzzle_part, std::istream& puzzle_input)
 							}
 						} else {
 							if (!unit_testing) s += "\e[37m";
-							if (tilemap[offset + x].enclosed) {
+							if (tilemap(x, y).enclosed) {
 								c = '#';
 							} else {
 								c = '_';
 							}
 						}
 						for (int subx = x * 3; subx < x * 3 + 3; ++subx) {
-							auto pix = params->bitmap[suboffset + subx];
+							auto pix = params.bitmap(subx, suby);
 							if (pix) s += c; else s+= " ";
 						}
-						std::cout << s;
+						line << s;
 					}
-					std::cout << std::endl;
 				}
 			}
 		}
 	}
 
-	delete[] tilemap;
-	delete params;
-
-	if (debug) std::cout << "Total: " << total << "\n" << std::endl;
+	if (log_debug()) log_line() << "Total: " << total << "\n";
 
 	return total;
 }
 
 
+long day10(int puzzle_part, std::istream& puzzle_input)
+{
+	day10_input map;
+	std::string text(std::istreambuf_iterator<char>(puzzle_input), {});
+	readtiles(map, text);
+	return pipeloop(puzzle_part, map);
+}
+
+
+std::unique_ptr<parsed_input> day10_parse(std::string_view puzzle_input)
+{
+	auto parsed = std::make_unique<day10_input>();
+	readtiles(*parsed, puzzle_input);
+	return parsed;
+}
+
+long day10_part1(const parsed_input& input) { return pipeloop(1, static_cast<const day10_input&>(input)); }
+long day10_part2(const parsed_input& input) { return pipeloop(2, static_cast<const day10_input&>(input)); }
+
+
 /*
 This puzzle was the turning point this year. Implementing the bitmap and
 flood-filling it was just too much work and not enough fun, so I took
@@ -147,9 +147,14 @@ pair of galaxies. What is the sum of these lengths?
 #include <functional>
 #include <numeric>
 #include <set>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <vector>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cctype>
 #include <cmath>
@@ -157,114 +162,186 @@ pair of galaxies. What is the sum of these lengths?
 #include <cassert>
 
 #include "aoc.h"
-
-
-// Coordinate location.
-struct coord {
-	int x;
-	int y;
-
-	friend inline bool operator==(const coord& lhs, const coord& rhs) { return ((lhs.x == rhs.x) && (lhs.y == rhs.y)); }
-	friend inline coord operator-(const coord& lhs, const coord& rhs) { return { lhs.x - rhs.x, lhs.y - rhs.y }; }
+#include "aocarena.h"
+#include "aocgrid.h"
+#include "aocinput.h"
+#include "aoclog.h"
+#include "aocserial.h"
+
+
+// Parsed puzzle input: the galaxy coordinates, and the number of galaxies on
+// each column and line of the image.  The image itself is not kept.
+struct day11_input : parsed_input {
+	std::pmr::vector<long> x { day_resource() };
+	std::pmr::vector<long> y { day_resource() };
+	std::pmr::vector<long> columns { day_resource() };
+	std::pmr::vector<long> lines { day_resource() };
 };
 
+// Count the galaxies on each column and line from their coordinates.
+void countgalaxies(day11_input& image, long width, long height)
+{
+	image.columns.assign(width, 0);
+	image.lines.assign(height, 0);
+	for (size_t i = 0; i < image.x.size(); ++i) {
+		image.columns[image.x[i]] += 1;
+		image.lines[image.y[i]] += 1;
+	}
+	if (log_debug()) {
+		{ log_line line; line << "Columns: "; print_vec(image.columns, line); }
+		{ log_line line; line << "Lines:   "; print_vec(image.lines, line); }
+	}
+}
 
-// Return a new set of integers consisting of numbers [0-N]
-// that are *not* in the input set [0-N].
-std::set<int> complement_set(std::set<int> s)
+// Read galaxies from puzzle input.  The image is needed only here, so it is
+// not allocated from the day resource, which lives as long as the parsed input.
+void readimage(day11_input& image, std::string_view puzzle_input)
 {
-	std::set<int> n;
-	for (int i = 0; i < *s.rbegin(); ++i) {
-		if (!s.contains(i)) n.insert(i);
+	auto grid = Grid<char>::load(puzzle_input, '.', std::pmr::new_delete_resource());
+	for (int y = 0; y < grid.height(); ++y) {
+		auto row = grid.row(y);
+		for (auto c = std::find(row.begin(), row.end(), '#'); c != row.end(); c = std::find(c + 1, row.end(), '#')) {
+			image.x.push_back(c - row.begin());
+			image.y.push_back(y);
+		}
 	}
-	return n;
+	countgalaxies(image, grid.width(), grid.height());
 }
 
 
-// For coordinate position pos, move it exp units forward for
-// each empty location.  In other words, add exp value to pos
-// as many times as there are empties smaller that the pos value.
-void expand_position(int* pos, const int exp, const std::set<int> empties) {
-	int add = 0;
-	for (auto it = empties.begin(); it != empties.end(); ++it) {
-		if (*pos < *it) break;
-		add += exp;
+// Sum of the distances between all pairs of galaxies along one axis.
+// 'galaxies' has the number of galaxies on each column or line, and each
+// one without galaxies is replaced with 'factor' empty ones.
+// Walking the axis in order, each galaxy is 'position' away from every
+// galaxy before it, minus their positions.
+long axisdistances(long factor, const std::pmr::vector<long>& galaxies)
+{
+	long total = 0;
+	long position = 0;	// Position after the expansion.
+	long before = 0;	// Galaxies before this position.
+	long sum = 0;		// Sum of their positions.
+	for (auto count : galaxies) {
+		total += count * (before * position - sum);
+		before += count;
+		sum += count * position;
+		position += (count > 0) ? 1 : factor;
 	}
-	*pos += add;
+	return total;
 }
 
 
-// Expand the universe: move all galaxy coordinates.
-void expand_universe(std::vector<coord>& galaxies, const int exp, const std::set<int> cols, const std::set<int> lines)
+// Sum of the shortest paths between galaxies, when each empty
+// column and line is replaced with 'factor' empty ones.
+// Shortest paths are Manhattan distances, so the axes add up separately.
+long distances(int factor, const day11_input& image)
 {
-	for (auto galaxy_it = galaxies.begin(); galaxy_it != galaxies.end(); ++galaxy_it) {
-		expand_position(&(galaxy_it->y), exp, lines);
-		expand_position(&(galaxy_it->x), exp, cols);
-	}
+	long total = axisdistances(factor, image.columns) + axisdistances(factor, image.lines);
+
+	if (log_debug()) log_line() << "Total: " << total;
+
+	return total;
 }
 
 
-long day11(int puzzle_part, std::istream& puzzle_input)
+// Sum of the shortest paths like distances(), but moving each galaxy by the
+// empty columns and lines before it and adding up the path of every pair.
+// This is the reference engine for validate.
+long pairdistances(int factor, const day11_input& image)
 {
-	long total = 0;	// Solution result is stored here.
-
-	std::vector<coord> galaxies;
-
-	// Read puzzle input.
-	int y = 0;
-	std::set<int> lines;
-	std::set<int> columns;
-	for (std::string line; std::getline(puzzle_input, line); ) {
-		int count = 0;
-		for (auto x = 0; x < line.length(); ++x) {
-			if ('#' == line.at(x)) {
-				galaxies.push_back(coord(x, y));
-				columns.insert(x);
-				count += 1;
-			}
+	// Position of each column or line after the expansion.
+	auto expand = [factor](const std::pmr::vector<long>& galaxies) {
+		std::pmr::vector<long> positions(day_resource());
+		long position = 0;
+		for (auto count : galaxies) {
+			positions.push_back(position);
+			position += (count > 0) ? 1 : factor;
+		}
+		return positions;
+	};
+	auto columns = expand(image.columns);
+	auto lines = expand(image.lines);
+
+	long total = 0;
+	for (size_t i = 0; i < image.x.size(); ++i) {
+		for (size_t j = i + 1; j < image.x.size(); ++j) {
+			total += std::abs(columns[image.x[j]] - columns[image.x[i]]) + std::abs(lines[image.y[j]] - lines[image.y[i]]);
 		}
-		if (count > 0) { lines.insert(y); }
-		y += 1;
-	}
-	auto noncolumns = complement_set(columns);
-	auto nonlines = complement_set(lines);
-	if (debug) {
-		std::cout << "Columns: "; print_set(noncolumns);
-		std::cout << "\nLines:   "; print_set(nonlines); std::cout << std::endl;
 	}
-	
+
+	if (log_debug()) log_line() << "Total: " << total;
+
+	return total;
+}
+
+
+long day11(int puzzle_part, std::istream& puzzle_input)
+{
+	day11_input image;
+	std::string text(std::istreambuf_iterator<char>(puzzle_input), {});
+	readimage(image, text);
+
 	// Expand the universe.
 	if (1 == puzzle_part) {
-		expand_universe(galaxies, 1, noncolumns, nonlines);	// Part 1
+		return distances(2, image);			// Part 1
 	} else if (10 == puzzle_part) {
-		expand_universe(galaxies, 10-1, noncolumns, nonlines);	// Unit test
+		return distances(10, image);		// Unit test
 	} else if (100 == puzzle_part) {
-		expand_universe(galaxies, 100-1, noncolumns, nonlines);	// Unit test
-	} else {
-		expand_universe(galaxies, 1000000-1, noncolumns, nonlines);	// Part 2
+		return distances(100, image);		// Unit test
 	}
+	return distances(1000000, image);		// Part 2
+}
 
-	if (debug) {
-		for (auto g : galaxies) {
-			std::cout << g.x << "," << g.y << "\n";
-		}
-	}
 
-	// Count distances
-	for (auto g_it = galaxies.begin(); g_it != galaxies.end(); ++g_it) {
-		for (auto gg_it = g_it + 1; gg_it != galaxies.end(); ++gg_it) {
-			//std::cout << "Path: " << std::distance(galaxies.begin(), g_it) + 1 << " -> " << std::distance(galaxies.begin(), gg_it) + 1 << "  ";
-			auto d = *gg_it - *g_it;
-			//std::cout << d.x << "," << d.y << "\n";
-			total += std::abs(d.x) + std::abs(d.y);
-		}
+// Binary input: the width and height of the image, and the x and y
+// coordinates of the galaxies.
+void day11_save(const parsed_input& input, std::string& out)
+{
+	const auto& parsed = static_cast<const day11_input&>(input);
+	serial_writer w(out);
+	w.put(parsed.columns.size());
+	w.put(parsed.lines.size());
+	w.put_all(parsed.x);
+	w.put_all(parsed.y);
+}
+
+// Largest image width or height accepted from binary input.  Each column
+// and line takes a counter, so this also bounds the memory of a crafted file.
+constexpr int64_t max_extent = int64_t(1) << 20;
+
+std::unique_ptr<parsed_input> day11_load(std::string_view data)
+{
+	auto parsed = std::make_unique<day11_input>();
+	serial_reader r(data);
+	int64_t width = 0, height = 0;
+	r.get(width);
+	r.get(height);
+	r.get_all(parsed->x);
+	r.get_all(parsed->y);
+	if (!r.at_end() || (parsed->x.size() != parsed->y.size()) || (width < 0) || (width > max_extent) || (height < 0) || (height > max_extent)) return nullptr;
+	for (size_t i = 0; i < parsed->x.size(); ++i) {
+		if ((parsed->x[i] < 0) || (parsed->x[i] >= width) || (parsed->y[i] < 0) || (parsed->y[i] >= height)) return nullptr;
 	}
+	countgalaxies(*parsed, width, height);
+	return parsed;
+}
 
-	if (debug) std::cout << "Total: " << total << std::endl;
+std::unique_ptr<parsed_input> day11_parse(std::string_view puzzle_input)
+{
+	std::string_view payload;
+	if (binary_payload(puzzle_input, 11, payload)) return valid_binary(day11_load(payload));
 
-	return total;
+	auto parsed = std::make_unique<day11_input>();
+	readimage(*parsed, puzzle_input);
+	return parsed;
 }
 
+long day11_part1(const parsed_input& input) { return distances(2, static_cast<const day11_input&>(input)); }
+long day11_part2(const parsed_input& input) { return distances(1000000, static_cast<const day11_input&>(input)); }
+
+// Galaxy pair engine, the reference for the one above.
+long day11_pairs_part1(const parsed_input& input) { return pairdistances(2, static_cast<const day11_input&>(input)); }
+long day11_pairs_part2(const parsed_input& input) { return pairdistances(1000000, static_cast<const day11_input&>(input)); }
+
 
 /*
 Part 2 was a classic AoC curveball, forcing rewrite of the part 1 algorithm
@@ -272,4 +349,8 @@ entirely.  Adding the expansion value to coordinate values is more elegant
 anyway - choosing the correct loop structure was the most important problem.
 
 Due to life and all, this puzzle was completed over two months later.
+
+The galaxy pairs do not need to be visited one by one: with the galaxies
+counted per column and line, the distances add up along each axis in one
+pass, whatever the size of the image.
 */
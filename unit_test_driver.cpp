@@ -0,0 +1,142 @@
+// Advent of Code 2023 Solutions by Arttu Kärpinlehto
+
+// Runs the tests of unit_tests.h without VSCode: first each test_dayNN()
+// as a regression check, then each day's examples as a micro-benchmark.
+//
+//	unit_test_driver [-v] [-n iterations] [day...]
+//
+// Tests run in a child process each, so that a failing assert is reported
+// and the other tests still run.  -v shows the debug output of the tests.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "aoclog.h"
+#include "aocmemory.h"
+#include "unit_tests.h"
+
+
+// Test function of each day.
+static const struct {
+	int day;
+	void (*test)();
+} tests[] = {
+	{ 1, test_day01 }, { 2, test_day02 }, { 3, test_day03 }, { 4, test_day04 },
+	{ 5, test_day05 }, { 6, test_day06 }, { 7, test_day07 }, { 8, test_day08 },
+	{ 9, test_day09 }, { 10, test_day10 }, { 11, test_day11 },
+};
+
+
+// Run a test in a child process.  Returns an empty string if it passed,
+// otherwise what went wrong.
+static std::string regression(void (*test)(), bool verbose)
+{
+	log_flush();
+	std::cout << std::flush;
+	pid_t pid = fork();
+	if (pid < 0) return std::string("fork: ") + strerror(errno);
+	if (0 == pid) {
+		if (!verbose) {
+			int null = open("/dev/null", O_WRONLY);
+			if (null >= 0) dup2(null, STDOUT_FILENO);
+		}
+		debug = verbose;
+		test();
+		log_flush();
+		std::cout << std::flush;
+		_exit(0);
+	}
+	int status = 0;
+	if (waitpid(pid, &status, 0) < 0) return std::string("waitpid: ") + strerror(errno);
+	if (WIFSIGNALED(status)) return strsignal(WTERMSIG(status));
+	if (WIFEXITED(status) && (0 != WEXITSTATUS(status))) return "exit status " + std::to_string(WEXITSTATUS(status));
+	return "";
+}
+
+
+// Per run averages of a micro-benchmark.
+struct measurement {
+	long iterations = 0;
+	double ns = 0;
+	double allocations = 0;
+	double bytes = 0;
+};
+
+// Run a test repeatedly, for the given number of iterations or, without
+// one, for at least 100 ms.
+static measurement microbench(void (*test)(), long iterations)
+{
+	using clock = std::chrono::steady_clock;
+	debug = false;
+	test();		// Warm-up.
+
+	measurement m;
+	auto a0 = allocation_snapshot();
+	auto t0 = clock::now();
+	auto elapsed = clock::duration::zero();
+	while ((iterations > 0) ? (m.iterations < iterations) : (elapsed < std::chrono::milliseconds(100))) {
+		test();
+		++m.iterations;
+		elapsed = clock::now() - t0;
+	}
+	m.ns = std::chrono::duration<double, std::nano>(elapsed).count() / m.iterations;
+	auto a1 = allocation_snapshot();
+	m.allocations = static_cast<double>(a1.allocations - a0.allocations) / m.iterations;
+	m.bytes = static_cast<double>(a1.bytes - a0.bytes) / m.iterations;
+	return m;
+}
+
+
+int main(int argc, char* argv[])
+{
+	bool verbose = false;
+	long iterations = 0;
+	std::vector<int> days;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "-v") verbose = true;
+		else if ((arg == "-n") && (i + 1 < argc)) iterations = std::max(1, atoi(argv[++i]));
+		else if (atoi(arg.c_str()) > 0) days.push_back(atoi(arg.c_str()));
+		else {
+			std::cerr << "Usage: " << argv[0] << " [-v] [-n iterations] [day...]" << std::endl;
+			return 1;
+		}
+	}
+
+	// Every allocation of the tests is counted, so the examples can be
+	// measured in allocations per run.
+	counting_allocations = true;
+
+	int failures = 0;
+	std::cout << "Day  Test    " << std::setw(10) << "Iterations" << std::setw(14) << "ns/op"
+		<< std::setw(14) << "Allocs/op" << std::setw(14) << "Bytes/op" << "\n";
+	for (const auto& t : tests) {
+		if (!days.empty() && (std::find(days.begin(), days.end(), t.day) == days.end())) continue;
+
+		auto error = regression(t.test, verbose);
+		std::cout << std::setw(3) << t.day << "  ";
+		if (!error.empty()) {
+			++failures;
+			std::cout << "FAIL    " << error << std::endl;
+			continue;
+		}
+		auto m = microbench(t.test, iterations);
+		std::cout << "pass    " << std::setw(10) << m.iterations << std::fixed << std::setprecision(0)
+			<< std::setw(14) << m.ns << std::setprecision(1)
+			<< std::setw(14) << m.allocations << std::setprecision(0)
+			<< std::setw(14) << m.bytes << std::endl;
+	}
+
+	if (failures > 0) std::cout << failures << " test" << ((failures > 1) ? "s" : "") << " failed" << std::endl;
+	return (failures > 0) ? 1 : 0;
+}
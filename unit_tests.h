@@ -2,8 +2,11 @@
 
 #include <cassert>
 #include <sstream>
+#include <string>
 
 #include "aoc.h"
+#include "aocisa.h"
+#include "aocserial.h"
 
 // Global flags.
 bool debug = true;
@@ -29,6 +32,20 @@ xtwone3four\n\
 zoneight234\n\
 7pqrstsixteen";
 	assert(281 == day01(2, input2));
+
+	// Parse once, solve from the parsed state.
+	std::string text = input2.str();
+	assert(281 == day01_part2(*day01_parse(text)));
+
+	// Digit kernels of each instruction set level, with lines long enough
+	// for the vector blocks.
+	std::string long_lines = "1abc2\nabcdefghijklmnopqrstuvwxyz3abcdefghijklmnopqrstuvwxyzabcdefghijklm4nopqrstuvwxyz\n"
+		"abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz5abcdefghijklmnopqrstuvwxyz\n";
+	auto level = current_isa();
+	for (auto name : { "scalar", "sse4.2", "avx2", "avx512" }) {
+		if (select_isa(name)) assert(12 + 34 + 55 == day01_part1(*day01_parse(long_lines)));
+	}
+	select_isa(isa_name(level));
 }
 
 
@@ -45,6 +62,12 @@ Game 5: 6 red, 1 blue, 3 green; 2 blue, 1 red, 2 green";
 	input.clear();
 	input.seekg(0);	// reset and rewind the stream
 	assert(2286 == day02(2, input));
+
+	// Parse once, solve both parts from the parsed state.
+	std::string text = input.str();
+	auto parsed = day02_parse(text);
+	assert(8 == day02_part1(*parsed));
+	assert(2286 == day02_part2(*parsed));
 }
 
 
@@ -66,6 +89,15 @@ void test_day03() {
 	input.clear();
 	input.seekg(0);	// reset and rewind the stream
 	assert(467835 == day03(2, input));
+
+	// Parse once, solve both parts from the parsed state.
+	std::string text = input.str();
+	auto parsed = day03_parse(text);
+	assert(4361 == day03_part1(*parsed));
+	assert(467835 == day03_part2(*parsed));
+
+	// Bounding box engine.
+	assert((4361 == day03_box_part1(*parsed)) && (467835 == day03_box_part2(*parsed)));
 }
 
 
@@ -83,6 +115,12 @@ Card 6: 31 18 13 56 72 | 74 77 10 23 35 67 36 11";
 	input.clear();
 	input.seekg(0);	// reset and rewind the stream
 	assert(30 == day04(2, input));
+
+	// Parse once, solve both parts from the parsed state.
+	std::string text = input.str();
+	auto parsed = day04_parse(text);
+	assert(13 == day04_part1(*parsed));
+	assert(30 == day04_part2(*parsed));
 }
 
 
@@ -128,6 +166,30 @@ humidity-to-location map:\n\
 	input.clear();
 	input.seekg(0);	// reset and rewind the stream
 	assert(46 == day05(2, input));
+
+	// Parse once, solve both parts from the parsed state.
+	std::string text = input.str();
+	auto parsed = day05_parse(text);
+	assert(35 == day05_part1(*parsed));
+	assert(46 == day05_part2(*parsed));
+
+	// Brute force engine.
+	assert(35 == day05_brute_part1(*parsed));
+	assert(46 == day05_brute_part2(*parsed));
+
+	// Vector kernel of each instruction set level.
+	auto level = current_isa();
+	for (auto name : { "scalar", "sse4.2", "avx2", "avx512" }) {
+		if (select_isa(name)) assert((35 == day05_vector_part1(*parsed)) && (46 == day05_vector_part2(*parsed)));
+	}
+	select_isa(isa_name(level));
+
+	// Parsed state through the cache serialisation.
+	std::string saved;
+	day05_save(*parsed, saved);
+	auto loaded = day05_load(saved);
+	assert(loaded && (35 == day05_part1(*loaded)) && (46 == day05_part2(*loaded)));
+	assert(!day05_load(saved.substr(8)));
 }
 
 
@@ -142,6 +204,16 @@ Distance:  9  40  200";
 	input.clear();
 	input.seekg(0);	// reset and rewind the stream
 	assert(71503 == day06(2, input));
+
+	// Parse once, solve both parts from the parsed state.
+	std::string text = input.str();
+	auto parsed = day06_parse(text);
+	assert(288 == day06_part1(*parsed));
+	assert(71503 == day06_part2(*parsed));
+
+	// Loop engine.
+	assert(288 == day06_loop_part1(*parsed));
+	assert(71503 == day06_loop_part2(*parsed));
 	//assert(false);
 }
 
@@ -160,6 +232,25 @@ QQQJA 483";
 	input.clear();
 	input.seekg(0);	// reset and rewind the stream
 	assert(5905 == day07(2, input));
+
+	// Parse once, solve both parts from the parsed state.
+	std::string text = input.str();
+	auto parsed = day07_parse(text);
+	assert(6440 == day07_part1(*parsed));
+	assert(5905 == day07_part2(*parsed));
+
+	// Binary input.
+	std::string binary;
+	write_binary_header(binary, 7);
+	day07_save(*parsed, binary);
+	auto loaded = day07_parse(binary);
+	assert((6440 == day07_part1(*loaded)) && (5905 == day07_part2(*loaded)));
+
+	// Equal hands are ranked in input order, whether streamed or parsed.
+	std::stringstream equal;
+	equal << "32T3K 1\nKK677 5\n32T3K 2";
+	assert(20 == day07(1, equal));
+	assert(20 == day07_part1(*day07_parse(equal.str())));
 }
 
 
@@ -217,6 +308,19 @@ void test_day09() {
 	input.clear();
 	input.seekg(0);	// reset and rewind the stream
 	assert(2 == day09(2, input));
+
+	// Parse once, solve both parts from the parsed state.
+	std::string text = input.str();
+	auto parsed = day09_parse(text);
+	assert(114 == day09_part1(*parsed));
+	assert(2 == day09_part2(*parsed));
+
+	// Binary input, used in place.
+	std::string binary;
+	write_binary_header(binary, 9);
+	day09_save(*parsed, binary);
+	auto loaded = day09_parse(binary);
+	assert((114 == day09_part1(*loaded)) && (2 == day09_part2(*loaded)));
 }
 
 
@@ -302,6 +406,11 @@ void test_day11() {
 
 	assert(374 == day11(1, input1));
 
+	// Parse once, solve from the parsed state.
+	std::string text = input1.str();
+	assert(374 == day11_part1(*day11_parse(text)));
+	assert(374 == day11_pairs_part1(*day11_parse(text)));
+
 	std::stringstream input2;
 	input2 <<
 "...#......\n\
@@ -330,4 +439,12 @@ void test_day11() {
 #...#.....";
 	assert(8410 == day11(100, input3));
 
+	// Binary input.
+	auto parsed = day11_parse(text);
+	std::string binary;
+	write_binary_header(binary, 11);
+	day11_save(*parsed, binary);
+	auto loaded = day11_parse(binary);
+	assert((374 == day11_part1(*parsed)) && (374 == day11_part1(*loaded)));
+	assert(day11_part2(*parsed) == day11_part2(*loaded));
 }